@@ -49,21 +49,130 @@
  *            vector<int>A_star_path[N], A_star_dist, bus_line : A*㷨е·,ԼվĴ
  *            typedef pair<int, int>pii : pairض
  *            map<pii, bool>mp : ڹվɾͲ
- *            map<int, bool>bus : жϹվ
+ *            StationSet bus : ڲŴŵվλͼ,жϹվ
  *            bool vis[N] : жЩվûֹ
+ *            atomic<int> ds_dist[N] : delta-steppingʹԭɳڵľ
+ *            int graph_version : ͼİ汾,ÿμӱɾ߶һ,жϸǷ
+ *            vector<int> snap_off, snap_to, snap_eid, snap_wt[2] : ͼĽտ(CSR),վ±Ϊ±
+ *            vector<int> apsp_dist[2], apsp_cnt[2], apsp_pre[2] : ȫԴ·,·ǰ
+ *            vector<int> alt_mark[2], alt_d[2] : ALTĵرԼÿվ㵽رľ(վ)
+ *            vector<int> ch_pos[2], ch_off[2], ch_to[2], ch_w[2] : ΰ㼶Ӹߵкϱ
+ *            HubIndex hub[2] : ǩ,ÿվıǩŦ,ѹ,ֱӳļʹ
+ *            int iso_dist[N], iso_touched : ԤƵʹõľԼʹվ
+ *            int to_inner[N], to_outer[N] : ±źⲿվڲŵĶӦϵ
+ *            double geo_lat[N], geo_lon[N], geo_x[N], geo_y[N] : վľγԼͶӰƽ()
+ *            vector<int> grid_off, grid_item : ռ,վ
+ *            string dict_arena, vector<DictKey> dict_keys : ŵվƺͱ,ԼÿƻӦվ
+ *            vector<int> dict_seed, dict_slot : ƺͱСϣ(ÿͰ,ÿλöӦ)
+ *            vector<unsigned char> cg_bytes, cg_wt[2] : ѹͼвֱ䳤ھӱԼѹȨֵ
+ *            int comp_p[N] : άÿվͨĲ鼯,ӱʱϲ,ɾߺ޸
+ *            bool journal_enabled : Ƿպ޸־,ĬϹر
+ *            FILE *journal_fp, int journal_seq, journal_count : ޸־ļ,־Լպ־
+ *            vector<pii> td_pool, int td_prof[N] : ·ιõʱʻʱ߳,Լÿʹõ
+ *            vector<Connection> csa_conn : ʱ̱аʱа
+ *            QueryContext query_ctx : ǰĽֹʱ,ȡԼ״̬
+ *            int query_budget[2] : ѯطʱԤ(),0ʾ
+ *            vector<array<int, 4>> check_segs, vector<vector<int>> check_d[2] : Լбͼ·Լ֮Ļ׼
  *        :
  *            void create_BusStop() : нͼ
  *            void add() : ڽнͼ
- *            void A-star() : ʹA*㷨мk·
+ *            void add_route() : ͼʱһ˫·߲¼վ
+ *            int in_id(), out_id() : ⲿվڲ֮ת
+ *            void dict_build(), int dict_lookup() : ƺͱСϣ,ƻվ
+ *            int read_station() : һվ,Ǳ,ƻ,·ʱԷµı
+ *            bool station_missing() : վ,вڵľ͸ʾ
+ *            int comp_find(), bool comp_connected() : ѯͨǩ,O(1)жվǷͨ
+ *            void comp_reset(), comp_repair() : ͨǩԼɾߺ޸ǩ
+ *            void A-star() : ʹA*㷨мk·,ALTҪdijkstra
  *            void dijkstra_dist() : 㵥Դ̾
  *            void dijkstra_cost() : 㵥Դ̻
+ *            void delta_stepping() : ߳delta-stepping㵥Դ̾/С
+ *            void snap_build() : ݵǰڽӱɽտ
+ *            void apsp_build() : ̼߳ȫԴ·
+ *            void apsp_refresh() : ޸ͼ¼ڵȫԴ·
+ *            bool apsp_query() : ش̾/С
+ *            void snap_dijkstra() : ڿϼ㵥Դ·,Ԥʹ
+ *            void alt_build(), bool alt_ready() : ALTرѡԤ
+ *            int alt_bound() : ǲʽ½
+ *            bool goal_query() : ʹALT½ֱ߾½A*㵽ѯ
+ *            void ch_build() : վ,(CH)
+ *            void phast_batch() : PHASTһμһԶ·
+ *            void hub_build() : ֦رעǩ浽ļ
+ *            bool hub_map() : ѱǩļӳ䵽ڴ
+ *            int hub_query() : ϲվıǩõ̾С
+ *            bool alternative_routes() : ͷɼԵıѡ·
+ *            int betweenness() : ߳Brandes㷨վ·εĽ
+ *            void find_cut_points() : һηǵݹDFSҳź͸
+ *            bool query_expired(), query_tick() : ѭЭʽؼǷʱȡ
+ *            int run_with_budget() : ýֹʱִһ,ؽ״̬
+ *            int td_static(), td_travel() : ·εľ̬ʻʱԼĳʱ̵ʻʱ()
+ *            int td_dijkstra() : ʱ̼絽ʱʱdijkstra
+ *            void csa_sort() : Ӱʱ,ͬһӵ0ӰȺ
+ *            int csa_earliest() : ɨ㷨絽ʱ
+ *            int csa_profile() : ɨ㷨ʱ䴰в֧ĳ
+ *            void bounded_search() : ,Ԥǰֹdijkstra
+ *            void geo_project(), geo_grid_build() : ѾγͶӰƽ,
+ *            bool geo_ready(), int geo_bound() : ֱ߾½ǷԼ½ֵ
+ *            void geo_nearest(), geo_radius() : ѯkվԼ뾶ڵվ
+ *            void reorder_stations() : BFS,RCMϣ˳վ±Ųؽڽӱ
+ *            long long count_cache_miss() : ģ⻺ͳһdijkstraĻȱʧ
+ *            void cg_build() : ݿѹͼ
+ *            void dijkstra_compressed() : ѹͼϼ㵥Դ̾/С
  *            void query_dist() : ̾
  *            void query_cost() : С
  *            void quert_count_dist_and_cost() : ж·
  *            void make_delete() : ɾվһ
  *            void make_new() : վһ
+ *            bool route_exists(), route_can_add() : д־֮ǰжɾߺͼӱܷɹ
+ *            bool apply_delete(), apply_new() : ޸ͼɾߺͼӱ߲,־طŹ
+ *            void journal_append() : ޸ͼ֮ǰ׷һУ־
+ *            bool journal_sync() : ѿջ־ļд
+ *            bool journal_checkpoint() : ղ־
+ *            bool journal_recover() : ʱȡղط־
+ *            void make_checkpoint() : ֶ
+ *            void set_alt_mode() : رALTر
  *            void get_bus_line() : ȡеվϢ
  *            void get_bus_single() : ȡվϢ
+ *            void query_parallel_sssp() : Աȴ벢еԴ·ʱͼٱ
+ *            void set_apsp_mode() : رȫԴ·ģʽ
+ *            void query_reachable() : ѯԤܵվ
+ *            void make_reorder() : ±Ų±ǰľֲԶԱ
+ *            void set_td_profile() : ·εʱʻʱ
+ *            void query_td() : ʱ̲ѯ絽ʱ
+ *            void load_timetable() : ¼ʱ̱
+ *            void query_timetable() : ʱ̱ѯ絽ʱ䴰ڵĳ
+ *            void query_accessibility() : ʹPHASTվĿɴԱ
+ *            void query_hub() : ,ǩѯվľͻ
+ *            void query_alternatives() : ѯվ֮ıѡ·
+ *            void load_coordinates() : ¼վľγ
+ *            void query_nearby() : ѯĳλøվ
+ *            void load_station_names() : ¼վƺͱ
+ *            void query_betweenness() : ·վ·
+ *            void query_disruption() : йرպʹ·Ͽ·κվ
+ *            void set_query_budget() : õѯطʱԤ
+ *            void run_batch() : ִ,ѯط,ÿ״̬ʱ
+ *            void check_expect(), check_io() : Լм¼һκ˶Խ,һִֵһ
+ *            bool check_graph(), void check_load() : ɱֵͼ,ֵ·½ͼ׼
+ *            void check_delta_stepping() : Ͱ߳˶delta-stepping
+ *            void check_apsp() : ˶ȫԴ·ľ,·,·ԼںΪ
+ *            void check_bounded_search() : ˶Ԥڶܵվ;
+ *            void check_reorder() : ַʽ±ź˶Աת·
+ *            void check_compressed() : ˶ѹͼϵdijkstra
+ *            void check_components() : ɾ,ͨǩBFS˶
+ *            void check_journal() : ޸Ĳģ,˶Դӿպ־ָ·
+ *            void check_alt() : ˶ALTر½A*
+ *            void check_td() : ʱ°td_dijkstra뷴ɳڵĽ˶
+ *            int csa_brute(), void check_csa() : 巴ɳӼ絽ʱ,˶ɨ
+ *            void check_phast() : ˶CH/PHAST
+ *            void check_hub() : ˶½ĺʹļӳǩ
+ *            void check_alternatives() : ˶Աѡ·ߵĳ,ͨԺͻͬ
+ *            void check_geo() : ˶ֱ߾½A*ԼͰ뾶ڵվ
+ *            void check_dict() : ˶ƺͱϣ
+ *            void check_betweenness() : öվԺ˶Brandes
+ *            void check_cut_points() : ɾ·κվBFS˶ź͸
+ *            void check_batch(), check_status(), check_partial() : ˶ִе˳,ʱȡ״̬ԼʱĲֽ
+ *            int self_check() : ͼиܽ
+ *            void query_compressed() : ѹͼ,նԱڴռúͲѯٶ(ֻڲ)
  *            pprint() : ӡϢ
  **********************************************************/
 
@@ -97,18 +206,30 @@
 #include <stdexcept>
 #include <algorithm>
 #include <windows.h>
+#include <io.h>
 #include <iostream>
 #include <numeric>
+#include <random>
+#include <sstream>
 #include <cstring>
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
 #include <utility>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <array>
 #include <memory>
 #include <vector>
 #include <queue>
 #include <cmath>
 #include <set>
 #include <map>
+#include <functional>
 
 using namespace std;
 /**********************ʵС*****************************
@@ -272,9 +393,226 @@ int p[N]; // 
 vector<int> A_star_path[N], A_star_dist, bus_line; // A*㷨е·,ԼվĴ
 typedef pair<int, int> pii;
 map<pii, bool> mp;  // ڹվɾͲ
-map<int, bool> bus; // жϹվ
+
+class StationSet // ڲŴŵվλͼ,map<int, bool>,ѯΪO(1)
+{
+public:
+    class reference // bus[x] = true ʱʹõĴ
+    {
+    public:
+        reference(unsigned long long &word, unsigned long long mask) : word(word), mask(mask) {}
+        operator bool() const { return word & mask; }
+        reference &operator=(bool x)
+        {
+            if (x)
+                word |= mask;
+            else
+                word &= ~mask;
+            return *this;
+        }
+        reference &operator=(const reference &x) { return *this = (bool)x; }
+
+    private:
+        unsigned long long &word;
+        unsigned long long mask;
+    };
+
+    StationSet() : bits((N + 63) / 64, 0) {}
+    reference operator[](int x) // ԽıŶΪfalse,д뱻
+    {
+        if (x < 0 || x >= N)
+            return reference(spare, 0);
+        return reference(bits[x >> 6], 1ULL << (x & 63));
+    }
+    void swap(StationSet &x) { bits.swap(x.bits); }
+
+private:
+    vector<unsigned long long> bits;
+    unsigned long long spare = 0;
+};
+StationSet bus; // жϹվ
 bool vis[N], vis_bus[N];
 
+atomic<int> ds_dist[N]; // delta-steppingеľ, ʹԭɳ
+int ds_mark[N];         // ϲͰʱȥر
+const int DS_MAX_BUCKETS = 1 << 16; // delta-steppingѭʹõͰ
+
+const int TD_PERIOD = 1440; // ʻʱߵ,һķ
+const int TD_SPEED = 250;   // ûߵ·ΰƽ(/,ͣվԼ15km/h)Ѿ뻻Ϊʻʱ
+vector<pii> td_pool;        // ߵĶϵ(ʱ,ʻʱ),
+vector<int> td_start = {0}; // kߵĶϵΪ td_pool[td_start[k-1]] ~ td_pool[td_start[k]-1]
+int td_prof[N];             // ÿʹõ߱,0ʾTD_SPEEDdis㾲̬ʻʱ
+vector<int> td_arrive;      // ʱdijkstraиվ絽ʱ
+
+struct Connection // ʱ̱еһΰ: ĳ˳һվ,ͣصһվ
+{
+    int dep_stop, arr_stop, dep_time, arr_time, trip;
+    bool operator<(const Connection &W) const // ʱͬʱȵǰ,0ӵӲܽͬһӳ
+    {
+        if (dep_time != W.dep_time)
+            return dep_time < W.dep_time;
+        return arr_time < W.arr_time;
+    }
+};
+vector<Connection> csa_conn;       // ʱź,
+int csa_trips;                     // ε,αΪ0~csa_trips-1
+vector<int> csa_arr;               // ɨʱվ絽ʱ
+vector<int> csa_in;                // վõ±,·
+vector<int> csa_trip_in;           // ÿ˳ĸϳ,-1ʾ
+
+int graph_version; // ͼİ汾,ÿ޸ͼһ
+
+int snap_version = -1, snap_n;             // նӦͼ汾Լеվ
+int snap_id[N];                            // վڿе±,-1ʾڿ
+vector<int> snap_station;                  // ±Ӧվ
+vector<int> snap_off, snap_to, snap_eid;   // յCSRڽӱ,snap_eidΪӦԭ±
+vector<int> snap_wt[2];                    // ÿߵȨֵ,0Ϊ,1Ϊ
+
+const int APSP_MAX = 3000;                 // ȫԴ·վ
+bool apsp_enabled;                         // ǷȫԴ·ģʽ
+int apsp_version = -1, apsp_n;             // Ӧͼ汾Լվ
+vector<int> apsp_dist[2], apsp_cnt[2];     // ȫԴ̾/СԼ·, s*apsp_n+t 
+vector<unsigned short> apsp_pre[2];        // sΪ·tǰ(±)
+
+const int ALT_LANDMARKS = 8;     // ALTĵر
+bool alt_enabled;                // ǷALT
+int alt_version[2] = {-1, -1};   // ȨֵALTӦͼ汾
+vector<int> alt_mark[2];         // ѡĵر(±)
+vector<int> alt_d[2];            // վvlرľ, v*ALT_LANDMARKS+l 
+
+const int PHAST_LANES = 8;                  // PHASTһͬʱ
+const int CH_CORE_DEGREE = 32;              // ʣµվֵʱֹͣ,Ϊı
+int ch_version[2] = {-1, -1};               // ȨֵζӦͼ汾
+int ch_shortcuts[2];                        // ʱĽݾ
+vector<int> ch_pos[2];                      // ±ڰ㼶Ӹߵкλ
+vector<int> ch_off[2], ch_to[2], ch_w[2];   // λôŵϱ(ָ㼶,λøСվ,ڵı򶼴)
+
+const int ROUTE_ROUNDS = 8;            // ͷ,Ҫ·޹
+const double ROUTE_STRETCH = 1.4;     // ѡ··ߵĶٱ
+const double ROUTE_OVERLAP = 0.6;     // ѡ·غϵĲռ·ߵı
+const double ROUTE_LOCAL = 0.25;      // ֲżĴռ·ߵı
+const double ROUTE_PENALTY = 0.5;     // ·ÿѡһ,ȨֵԭȨֵı
+
+const char *HUB_FILE[2] = {"bus_hub_dist.bin", "bus_hub_cost.bin"}; // Ȩֵıǩļ
+const unsigned int HUB_MAGIC = 0x48535542;                          // ǩļͷʶ "BUSH"
+
+struct HubHeader // ǩļͷ, entry_off,byte_off,dist,bytes ĸ
+{
+    unsigned int magic;
+    int type, n, entries, bytes;
+    unsigned int graph_crc; // ʱյУֵ,жǷ
+    unsigned int crc;       // ĸУֵ
+};
+
+struct HubIndex // һȨֵǩ,ݿڴ,Ҳӳļ
+{
+    const HubHeader *head = nullptr;
+    const int *entry_off = nullptr;       // ÿվһǩ±
+    const int *byte_off = nullptr;        // ÿվһǩŦbytesеλ
+    const int *dist = nullptr;            // ÿǩŦľ򻨷
+    const unsigned char *bytes = nullptr; // Ŧ,ֺñ䳤
+    vector<char> buffer;                  // ս
+    HANDLE file = INVALID_HANDLE_VALUE, mapping = nullptr;
+    const void *view = nullptr; // ӳļͼ
+    int version = -1;           // ȷ뵱ǰͼһʱͼ汾
+} hub[2];
+
+int iso_dist[N];         // ԤƵеľ,ֻڱʹվ
+bool iso_vis[N];         // ԤƵѾѵվ
+bool iso_init;           // iso_distǷѾʼ
+vector<int> iso_touched; // бʹվ
+
+bool reordered;               // վǷѾ±
+int to_inner[N], to_outer[N]; // ⲿ->ڲ,ڲ->ⲿ,-1ʾ
+int inner_cnt;                // Ѿȥڲ
+
+int cg_version = -1;                  // ѹͼӦͼ汾
+vector<unsigned int> cg_node_off;     // ÿվھӱcg_bytesеʼλ
+vector<unsigned int> cg_edge_off;     // ÿվĵһȨֵе±
+vector<unsigned char> cg_bytes;       // ,ñ䳤ھӱ
+vector<unsigned char> cg_wt[2];       // ȥСֵ1/2/4ֽڴŵľͻ
+int cg_width[2], cg_base[2];          // ȨֵÿռõֽԼȥСֵ
+
+int comp_p[N];        // ͨĲ鼯,Ϊǩ
+int comp_mark[N];     // ޸ͨʱķʱ
+int comp_stamp;       // ǰ޸õıֵ
+
+const char *SNAPSHOT_FILE = "bus_snapshot.bin"; // ·ļ
+const char *JOURNAL_FILE = "bus_journal.bin";   // ֮޸־ļ
+const unsigned int SNAPSHOT_MAGIC = 0x53535542; // ļͷʶ "BUSS"
+const int JOURNAL_COMPACT = 256;                // ־ﵽԶ
+const int JOURNAL_NEW = 1, JOURNAL_DELETE = 2;  // ־еĲ
+
+struct JournalRecord // һ޸־
+{
+    unsigned int seq;
+    int op, a, b, c, d;
+    unsigned int crc;
+};
+
+struct JournalSegment // еһ·
+{
+    int a, b, c, d;
+};
+
+struct SnapshotHeader // ļͷ
+{
+    unsigned int magic, n, count, last_seq, crc;
+};
+
+bool journal_enabled;    // Ƿպ޸־( --journal ʱ)
+FILE *journal_fp;        // ޸־ļ
+unsigned int journal_seq; // һ־
+int journal_count;       // ֮д־
+bool pending_checkpoint; // ־,ȱβ󱣴
+
+double geo_lat[N], geo_lon[N];   // վγȺ;(ڲ)
+double geo_x[N], geo_y[N];       // ƽγΪ׼ȾͶӰƽ,λΪ
+bool geo_has[N];                 // վǷ
+int geo_cnt;                     // վ
+double geo_lat0;                 // ͶӰʹõĻ׼γ()
+int geo_stamp;                   // ÿ仯һμһ,жͱǷ
+int geo_scale_version = -1, geo_scale_stamp = -1;
+double geo_scale;                // ·ξֱ߾֮ȵСֵ,ֱ߾ᳬʵ
+int grid_stamp = -1;             // Ӧgeo_stamp
+int grid_w, grid_h;              // 
+double grid_x0, grid_y0, grid_cell; // ½ǵԼӱ߳
+vector<int> grid_off, grid_item; // ÿӵվgrid_itemеʼλ
+
+struct DictKey // һվƻ
+{
+    int off, len; // dict_arenaеλúͳ
+    int station;  // Ӧվ(ڲ)
+};
+string dict_arena;           // ƺͱβӴ
+vector<DictKey> dict_keys;   // ƺͱ
+vector<int> dict_seed;       // ϣÿͰʹõ
+vector<int> dict_slot;       // ϣλ -> dict_keys±
+int dict_name[N], dict_code[N]; // վƺͱdict_keysе±+1,0ʾû
+
+const int QUERY_POINT = 0; // ѯ: վ֮·,վϢ
+const int QUERY_HEAVY = 1; // ط: ǰk·,ȫͼͳ,ɴ,
+const int QUERY_EDIT = 2;  // ޸ͼ,ֹʱ,Ҳȡ
+
+struct QueryContext // ǰĽֹʱȡ
+{
+    chrono::steady_clock::time_point deadline;
+    bool limited;        // Ƿ˽ֹʱ
+    atomic<bool> cancel; // Ctrl+Cʱλ
+    atomic<int> status;  // 0-  1-ʱ  2-ȡ
+};
+
+QueryContext query_ctx;
+atomic<bool> query_running;          // ִпȡĲѯ
+int query_budget[2] = {2000, 60000}; // ѯطʱԤ(),0ʾ
+bool batch_mode;                     // ִʱÿͣ
+
+mt19937 check_rng;                           // Լʹõ,ӹ̶,Ը
+vector<array<int, 4>> check_segs;            // Լбͼ·(վ,,)
+int check_S;                                 // ͼվ,վΪsnap_station[0~check_S-1]
+vector<vector<int>> check_d[2];              // dijkstraõ֮ľͻ(±)
+vector<pair<string, pii>> check_tally;       // ÿ,˶ԴͲһ´
+
 struct node
 {
     int pos, g, f;
@@ -297,6 +635,124 @@ struct Edge
     }
 };
 
+/*****************鵱ǰǷӦ*******************
+ * 鵱ǰǷȡѾֹʱ
+ *  
+ *  query_ctx.status
+ * ֵ true-Ӧ  false-
+ * ˵״̬һλͱֵ,֮ļֱӷtrue
+ ************************************************************/
+bool query_expired()
+{
+    if (query_ctx.status.load(memory_order_relaxed))
+        return true;
+    if (query_ctx.cancel.load(memory_order_relaxed))
+        query_ctx.status = 2;
+    else if (query_ctx.limited && chrono::steady_clock::now() >= query_ctx.deadline)
+        query_ctx.status = 1;
+    return query_ctx.status.load(memory_order_relaxed) != 0;
+}
+
+/*****************ѭеЭʽ*********************
+ * ڲѭе,ÿ1024βһʱ
+ *  
+ *  
+ * ֵ true-Ӧ  false-
+ * ˵̶߳,̵߳ҲԵ
+ ************************************************************/
+bool query_tick()
+{
+    static thread_local unsigned int tick;
+    if (query_ctx.status.load(memory_order_relaxed))
+        return true;
+    return (++tick & 1023) == 0 && query_expired();
+}
+
+/*****************ͣ**************************
+ * ʱͣһ鿴,ִʱͣ
+ *  
+ *  
+ * ֵ void
+ * ˵ʱ,ֱӵSleep
+ ************************************************************/
+void ui_pause(int ms)
+{
+    if (!batch_mode)
+        Sleep(ms);
+}
+
+/*****************Ctrl+CĴ**************************
+ * ѯаCtrl+Cʱֻȡβѯ,˳
+ *  ̨¼
+ *  query_ctx.cancel
+ * ֵ TRUE-Ѵ  FALSE-ϵͳĬϴ
+ * ˵޸ͼͽʱȡ,ʱĬϷʽ˳,־ʱ޸־֤ݲ
+ ************************************************************/
+BOOL WINAPI query_ctrl_handler(DWORD event)
+{
+    if (event != CTRL_C_EVENT || !query_running)
+        return FALSE;
+    query_ctx.cancel = true;
+    return TRUE;
+}
+
+/****************ѯվڵͨ***********************
+ * ѯվͨıǩ
+ * վ
+ * 
+ * ֵ ͨıǩ
+ * ˵ʹ·,ǵݹ,ܳʱҲᱬջ
+ ************************************************************/
+int comp_find(int x)
+{
+    while (comp_p[x] != x)
+    {
+        comp_p[x] = comp_p[comp_p[x]];
+        x = comp_p[x];
+    }
+    return x;
+}
+
+/****************ϲվڵͨ********************
+ * ϲվڵͨ
+ * վ
+ * 
+ * ֵ 
+ * ˵
+ ************************************************************/
+void comp_union(int a, int b)
+{
+    a = comp_find(a), b = comp_find(b);
+    if (a != b)
+        comp_p[a] = b;
+}
+
+/****************վͨ***********************
+ * ÿվ㵥Ϊһͨ
+ * 
+ * 
+ * ֵ 
+ * ˵½ͼ֮ǰ
+ ************************************************************/
+void comp_reset()
+{
+    iota(comp_p, comp_p + N, 0);
+}
+
+/****************жվǷͨ*************************
+ * жվǷͬһͨ
+ * վ
+ * 
+ * ֵ true-ͨ  false-ͨ
+ * ˵вѯǰȵ,ֱͨӷ
+ ************************************************************/
+bool comp_connected(int a, int b)
+{
+    if (a < 0 || a >= N || b < 0 || b >= N)
+        return false;
+    return a == b || comp_find(a) == comp_find(b);
+}
+
 /********************վ*****************************
  * վ
  * ʼ,ֹ,·ĻѺ;
@@ -308,61 +764,223 @@ void add(int a, int b, int c, int d)
 {
 
     // ͼĴ洢,ʹõڽӱͼ
-    e[idx] = b, w[idx] = c, dis[idx] = d, ne[idx] = h[a], h[a] = idx++;
+    e[idx] = b, w[idx] = c, dis[idx] = d, ne[idx] = h[a], td_prof[idx] = 0, h[a] = idx++;
+    graph_version++;
+    comp_union(a, b);
 }
 
-/*****************A-star㷨k̾**********************
- * A-star㷨k̾
- *  ,յ,k
+/*****************ͼʱһ·*********************
+ * ͼʱһ˫·,¼³ֵվ
+ * վ,Ѻ;
+ * 
+ * ֵ 
+ * ˵create_BusStopͶȡʱʹ
+ ************************************************************/
+void add_route(int u, int v, int c, int d)
+{
+    add(u, v, c, d), add(v, u, c, d); // 
+    if (!bus[u])
+    {
+        bus_line.push_back(u);
+        bus[u] = true;
+    }
+    if (!bus[v])
+    {
+        bus_line.push_back(v);
+        bus[v] = true;
+    }
+}
+
+/******************ⲿתΪڲ*************************
+ * ûվתΪʹõڲ
+ *  ⲿ,ʱǷµڲ
  *  
- * ֵ void
- * ˵ڼ
+ * ֵ ڲ,Ҳʱ0(±ź0Ųᱻʹ)
+ * ˵û±ʱڲⲿͬ
  ************************************************************/
-bool A_star(int st, int ed, int k)
+int in_id(int x, bool create = false)
 {
-    int num = 0, check = 0;
-    A_star_dist.clear();
-    if (st == ed)
-        k++;
+    if (!reordered)
+        return x;
+    if (x < 0 || x >= N)
+        return 0;
+    if (to_inner[x] == -1 && create && inner_cnt + 1 < N)
+    {
+        to_inner[x] = ++inner_cnt;
+        to_outer[inner_cnt] = x;
+    }
+    return to_inner[x] == -1 ? 0 : to_inner[x];
+}
 
-    if (dist[st] >= 0x3f3f3f3f / 2)
-        return false;
+/******************ڲתΪⲿ*************************
+ * ڲתΪûվ
+ *  ڲ
+ *  
+ * ֵ ⲿ
+ * ˵
+ ************************************************************/
+int out_id(int x)
+{
+    if (!reordered)
+        return x;
+    return to_outer[x];
+}
 
-    priority_queue<node> que;
-    que.push(node(st, 0, dist[st]));
+/******************ַĹϣֵ**************************
+ * վƻ64λϣֵ,ԼӺĹϣֵ
+ *  ַʼַͳ / ϣֵ
+ *  
+ * ֵ ϣֵ
+ * ˵FNV-1a,splitmix64
+ ************************************************************/
+unsigned long long dict_hash(const char *s_, int len)
+{
+    unsigned long long x = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < len; i++)
+        x = (x ^ (unsigned char)s_[i]) * 0x100000001b3ULL;
+    return x;
+}
 
-    while (!que.empty())
+unsigned long long dict_mix(unsigned long long x, unsigned long long seed)
+{
+    x ^= seed * 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/******************ƺͱϣ*********************
+ * Ϊdict_keysƺͱ뽨Сϣ(CHD)
+ *  
+ *  dict_seed, dict_slot
+ * ֵ void
+ * ˵ȰϣֵƷֵԼ K/4 Ͱ,ӴͰСͰΪÿͰ
+ *           һ,ʹͰ䵽ͬĿλ;
+ *           ѯʱֻιϣȽһַ,Ʊ뻥ͬ
+ ************************************************************/
+void dict_build()
+{
+    int K = dict_keys.size(), B = max(1, (K + 3) / 4);
+    vector<unsigned long long> hv(K);
+    vector<vector<int>> buckets(B);
+    for (int k = 0; k < K; k++)
     {
-        node now = que.top();
-        que.pop();
+        hv[k] = dict_hash(dict_arena.data() + dict_keys[k].off, dict_keys[k].len);
+        buckets[hv[k] % B].push_back(k);
+    }
+    vector<int> order(B);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](int a, int b)
+         { return buckets[a].size() > buckets[b].size(); });
 
-        // A_star_path[num].push_back(now.pos);
-        if (now.pos == ed)
+    dict_seed.assign(B, 0);
+    dict_slot.assign(K, -1);
+    vector<int> slots;
+    for (int b : order)
+    {
+        if (buckets[b].empty())
+            break;
+        for (int seed = 1;; seed++)
         {
-            check = 1;
-            num++;
-            A_star_dist.push_back(now.g);
-            // A_star_path[num].push_back(st);
+            slots.clear();
+            bool ok = true;
+            for (int k : buckets[b])
+            {
+                int x = dict_mix(hv[k], seed) % K;
+                if (dict_slot[x] != -1 || find(slots.begin(), slots.end(), x) != slots.end())
+                {
+                    ok = false;
+                    break;
+                }
+                slots.push_back(x);
+            }
+            if (!ok)
+                continue;
+            for (size_t q = 0; q < slots.size(); q++)
+                dict_slot[slots[q]] = buckets[b][q];
+            dict_seed[b] = seed;
+            break;
         }
-        if (num == k)
-            return true;
-        for (int i = h[now.pos]; ~i; i = ne[i])
-        {
-            node nex;
+    }
+}
 
-            if (e[i] == -1)
-                continue;
+/******************ƻվ*************************
+ * ͨϣƻӦվ
+ *  ƻ
+ *  
+ * ֵ ڲ,ʱ-1
+ * ˵ϣԲڵҲһλ,ҪȽһַ
+ ************************************************************/
+int dict_lookup(const string &key)
+{
+    if (dict_keys.empty())
+        return -1;
+    int K = dict_keys.size(), B = dict_seed.size();
+    unsigned long long x = dict_hash(key.data(), key.size());
+    const DictKey &item = dict_keys[dict_slot[dict_mix(x, dict_seed[x % B]) % K]];
+    if (item.len != (int)key.size() || dict_arena.compare(item.off, item.len, key) != 0)
+        return -1;
+    return item.station;
+}
 
-            nex.pos = e[i];
-            nex.g = now.g + dis[i];
-            // cout<<e[i]<<' '<<dis[i]<<' '<<nex.g<<endl;
-            nex.f = (now.g + dis[i]) + dist[e[i]];
-            que.push(nex);
+/******************һվ*******************************
+ * жһվ,Ǳ,ƻ
+ *  µıǷڲ(·ʱʹ)
+ *  
+ * ֵ ڲ,վ㲻ʱ-1
+ * ˵ȫ(ɴ)İŴ,ųΧ±ź
+ *           ûжӦվ(ҲѾ)ʱҲ㲻
+ ************************************************************/
+int read_station(bool create = false)
+{
+    string token;
+    cin >> token;
+    bool number = !token.empty() && token.find_first_not_of("0123456789", token[0] == '-') == string::npos &&
+                  token != "-";
+    if (!number)
+        return dict_lookup(token);
+    int x = atoi(token.c_str());
+    if (x < 0 || x >= N)
+        return -1;
+    int v = in_id(x, create);
+    return reordered && !v ? -1 : v;
+}
+
+/******************վ******************************
+ * read_stationվ,вڵľ͸ʾ
+ *  ɸվ
+ *  ʾϢ
+ * ֵ true-вڵվ
+ * ˵ǰӦòȫ,֮Ųλ
+ ************************************************************/
+bool station_missing(initializer_list<int> stations)
+{
+    for (int v : stations)
+        if (v < 0)
+        {
+            cout << endl
+                 << "վ㲻(ini)" << endl;
+            ui_pause(1500);
+            return true;
         }
-    }
     return false;
 }
 
+/******************վ**********************************
+ * ȡվƻ
+ *  վ(ڲ),0Ϊ,1Ϊ
+ *  
+ * ֵ ƻ,ûʱؿַ
+ * ˵
+ ************************************************************/
+string station_label(int v, int which)
+{
+    if (v < 0 || v >= N)
+        return "";
+    int k = which ? dict_code[v] : dict_name[v];
+    return k ? dict_arena.substr(dict_keys[k - 1].off, dict_keys[k - 1].len) : "";
+}
+
 /******************ʹdijkstra㷨·*******************
  * ʹdijkstra㷨·
  *  
@@ -385,6 +1003,8 @@ void dijkstra_dist(int st)
     cnt[st] = 1;
     while (!que.empty())
     {
+        if (query_tick()) // ʱȡ,distֻвֽ
+            break;
         auto now = que.top(); // ȡСѶѶԪ
         que.pop();            // ȡ˾Ҫ
 
@@ -433,6 +1053,8 @@ void dijkstra_cost(int st)
 
     while (!que.empty())
     {
+        if (query_tick()) // ʱȡ,distֻвֽ
+            break;
         auto now = que.top(); // ȡСѶѶԪ
         que.pop();            // ȡ˾Ҫ
 
@@ -461,518 +1083,5847 @@ void dijkstra_cost(int st)
     }
 }
 
-/***************ѯ·*******************
- * ѯ·
- *  
- *  ݾ
+/***************delta-stepping㵥Դ·***************
+ * ʹö߳delta-stepping㷨㵥Դ̾С
+ *  , (0Ϊ,1Ϊ), Ͱdelta, ߳
+ *  дdist, dijkstra_dist/dijkstra_costȫһ
  * ֵ void
- * ˵
+ * ˵ÿ̰߳ɳڳɹĵдԼͰ,
+ *           һֽͳһϲͰ, ɳʱԭCASȡСֵ;
+ *           ֻ߳һ, ÿ̻߳;
+ *           δĵ붼[b*delta, b*delta+Ȩ], Ͱѭʹ,
+ *           Ϊ Ȩ/delta+2, (ʱԶӴdelta);
+ *           ÿֿʼǰֹʱ,ʱȡʱdistֻвֽ
  ************************************************************/
-void query_min_dist(int operate)
+void delta_stepping(int st, int type, int delta, int threads)
 {
     /**
-    ֮·С,ʹõDijkstra㷨
-    ʱ临ӶN*logN,10000000ݷΧ
+     dist/delta ѵ벻ͬͰ, ÿδСķǿͰ,
+    ͬһͰڵĵԲɳ, ֱͰµĵ
     **/
-    cout << "Ҫѯ·յ: ";
-    cin >> st_min_dist >> ed_min_dist;
-
-    dijkstra_dist(st_min_dist);
+    if (delta < 1)
+        delta = 1;
+    if (threads < 1)
+        threads = 1;
 
-    if (dist[ed_min_dist] >= 0x3f3f3f3f / 2)
-    {
-        cout << endl
-             << "޷!" << endl
-             << endl;
+    int max_w = 0;
+    for (int i = 0; i < idx; i++)
+        if (e[i] != -1)
+            max_w = max(max_w, type ? w[i] : dis[i]);
+    if (max_w / delta > DS_MAX_BUCKETS) // deltaԱȨ̫СʱͰ̫,ӴdeltaӰ
+        delta = max_w / DS_MAX_BUCKETS + 1;
 
-        Sleep(1500);
-        return;
-    }
-    else if (operate == 1)
-        cout << endl
-             << "㵽յĵ̾Ϊ: " << dist[ed_min_dist] << endl
-             << endl;
+    for (int i = 0; i < N; i++)
+        ds_dist[i].store(0x3f3f3f3f, memory_order_relaxed);
+    memset(ds_mark, 0, sizeof ds_mark);
+    ds_dist[st].store(0, memory_order_relaxed);
 
-    memset(path, -1, sizeof path);
-    if (operate == 1)
-        cout << "·Ϊ: ";
-    int tmp1, tmp2, cnt = 1;
-    path[1] = ed_min_dist;
+    size_t cycle = max_w / delta + 2;                 // Ͱĸ,bͰ buckets[b % cycle]
+    vector<vector<int>> buckets(cycle);               // bͰ[b*delta,(b+1)*delta)ĵ
+    vector<vector<pii>> buffer(threads);              // ÿ߳ԼͰ,(,վ)
+    buckets[0].push_back(st);
+    long long pending = 1;                            // Ͱлûȡĵ
+    vector<int> frontier;
+    size_t b = 0;
+    int phase = 0;
 
-    for (int i = 0; !(tmp2 == st_min_dist); ++i)
+    // tid̴߳frontier±Ϊ tid, tid+step, ... ĵ
+    auto relax = [&](int tid, int step)
     {
-        if (i == 0)
-            tmp1 = ed_min_dist;
-        else
+        vector<pii> &buf = buffer[tid];
+        for (size_t k = tid; k < frontier.size(); k += step)
         {
-            tmp2 = pre[tmp1];
-            path[++cnt] = tmp2;
-            tmp1 = tmp2;
+            int u = frontier[k];
+            int du = ds_dist[u].load(memory_order_relaxed);
+            if (du / delta != (int)b) // õѾµСͰ
+                continue;
+            for (int i = h[u]; ~i; i = ne[i])
+            {
+                int j = e[i];
+                if (j == -1)
+                    continue;
+                int nd = du + (type ? w[i] : dis[i]);
+                int old = ds_dist[j].load(memory_order_relaxed);
+                while (nd < old)
+                {
+                    if (ds_dist[j].compare_exchange_weak(old, nd, memory_order_relaxed))
+                    {
+                        buf.push_back({nd, j});
+                        break;
+                    }
+                }
+            }
         }
-    }
+    };
 
-    if (operate == 1)
+    // ߳: ȴ̷߳µһ,󱨸,ֱ
+    mutex mtx;
+    condition_variable cv_start, cv_done;
+    int round = 0, running = 0, use = 1;
+    bool quit = false;
+    auto worker = [&](int tid)
     {
-        for (int i = cnt; i >= 2; i--)
-            cout << path[i] << " -> ";
-        cout << path[1] << endl;
-    }
+        int seen = 0;
+        while (true)
+        {
+            unique_lock<mutex> lock(mtx);
+            cv_start.wait(lock, [&]
+                          { return quit || round != seen; });
+            if (quit)
+                return;
+            seen = round;
+            int step = use;
+            lock.unlock();
+            if (tid < step)
+                relax(tid, step);
+            lock.lock();
+            if (--running == 0)
+                cv_done.notify_one();
+        }
+    };
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back(worker, t);
 
-    if (operate == 3)
+    for (; pending > 0 && !query_expired(); b++)
     {
-        cout << "Ҫѯǰk·: ";
-        int oper;
-        cin >> oper;
-        if (oper == -1)
-            return;
-        else
+        vector<int> &bucket = buckets[b % cycle];
+        while (!bucket.empty() && !query_expired())
         {
+            frontier.clear();
+            frontier.swap(bucket);
+            pending -= frontier.size();
 
-            dijkstra_dist(ed_min_dist);
-
-            if (!A_star(st_min_dist, ed_min_dist, oper))
-                cout << "" << endl;
+            // ̫ʱ̵߳òʧ,ֱӴд
+            use = (int)min<size_t>(threads, frontier.size() / 64 + 1);
+            if (use <= 1)
+                relax(0, 1);
             else
             {
-                for (int i = 0; i < oper; i++)
                 {
-                    cout << " " << i + 1 << " ·ĳΪ: " << A_star_dist[i] << endl;
-                    // if(i>0) cout<<st_min_dist<<' ';
-                    for (auto u : A_star_path[i])
-                        cout << u << ' ';
-                    cout << endl;
+                    lock_guard<mutex> lock(mtx);
+                    running = threads - 1;
+                    round++;
+                }
+                cv_start.notify_all();
+                relax(0, use);
+                unique_lock<mutex> lock(mtx);
+                cv_done.wait(lock, [&]
+                             { return running == 0; });
+            }
+
+            // ϲ̵߳Ļ,ֻȻ¾ĵ,ȥ
+            phase++;
+            for (auto &buf : buffer)
+            {
+                for (auto &item : buf)
+                {
+                    int nd = item.first, j = item.second;
+                    if (ds_dist[j].load(memory_order_relaxed) != nd || ds_mark[j] == phase)
+                        continue;
+                    ds_mark[j] = phase;
+                    buckets[(size_t)(nd / delta) % cycle].push_back(j);
+                    pending++;
                 }
+                buf.clear();
             }
         }
     }
 
-    Sleep(1500);
-    return;
+    {
+        lock_guard<mutex> lock(mtx);
+        quit = true;
+    }
+    cv_start.notify_all();
+    for (auto &th : pool)
+        th.join();
+
+    for (int i = 0; i < N; i++)
+        dist[i] = ds_dist[i].load(memory_order_relaxed);
 }
 
-/****************ѯС*********************
- * ѯС
- *  
- *  ݾ
+/*****************ͼĽտ***************************
+ * ѵǰڽӱδɾıCSR
+ *  
+ *  snap_ͷȫֱ
  * ֵ void
- * ˵
+ * ˵վ㰴ŴС±,ߵ˳ڽӱı˳һ,
+ *           ͼû޸ʱֱӸһεĿ
  ************************************************************/
-void query_min_cost()
+void snap_build()
 {
-    cout << "ҪѯСѵյ: ";
-    cin >> st_min_dist >> ed_min_dist;
+    if (snap_version == graph_version)
+        return;
 
-    dijkstra_cost(st_min_dist);
+    snap_station.clear();
+    for (int i = 0; i < N; i++)
+    {
+        snap_id[i] = -1;
+        if (h[i] != -1)
+        {
+            snap_id[i] = snap_station.size();
+            snap_station.push_back(i);
+        }
+    }
+    snap_n = snap_station.size();
 
-    if (dist[ed_min_dist] >= 0x3f3f3f3f / 2)
+    snap_off.assign(snap_n + 1, 0);
+    snap_to.clear(), snap_eid.clear(), snap_wt[0].clear(), snap_wt[1].clear();
+    for (int u = 0; u < snap_n; u++)
     {
-        cout << endl
-             << "޷!" << endl
-             << endl;
-        Sleep(1500);
-        return;
+        for (int i = h[snap_station[u]]; ~i; i = ne[i])
+        {
+            if (e[i] == -1)
+                continue;
+            snap_to.push_back(snap_id[e[i]]);
+            snap_eid.push_back(i);
+            snap_wt[0].push_back(dis[i]);
+            snap_wt[1].push_back(w[i]);
+        }
+        snap_off[u + 1] = snap_to.size();
     }
-    else
-        cout << endl
-             << "㵽յСΪ: " << dist[ed_min_dist] << endl
-             << endl;
+    snap_version = graph_version;
+}
 
-    memset(path, -1, sizeof path);
-    cout << "С·Ϊ: ";
-    int tmp1, tmp2, cnt = 1;
-    path[1] = ed_min_dist;
+/*****************̼߳ȫԴ·**********************
+ * ÿվһdijkstra,õȫԴ̾/С,·ǰ
+ *  
+ *  apsp_ͷȫֱ
+ * ֵ void
+ * ˵֮ͬ以Ӱ,ָ̲߳м,
+ *           ÿɳ˳dijkstra_dist/dijkstra_costȫͬ,˽һ;
+ *           ÿдǰһ:ǰݵõdijkstra·,
+ *           ·벻ʱͬ,Ȩ·¸еһָܻγɻ;
+ *           ֻڿ޸ͼ֮,ܲѯĽֹʱ
+ ************************************************************/
+void apsp_build()
+{
+    snap_build();
+    apsp_n = snap_n;
+    size_t total = (size_t)apsp_n * apsp_n;
+    for (int type = 0; type < 2; type++)
+    {
+        apsp_dist[type].assign(total, 0x3f3f3f3f);
+        apsp_cnt[type].assign(total, 0);
+        apsp_pre[type].assign(total, 0xffff);
+    }
 
-    for (int i = 0; !(tmp2 == st_min_dist); ++i)
+    auto work = [&](int tid, int step)
     {
-        if (i == 0)
-            tmp1 = ed_min_dist;
-        else
+        vector<int> d(apsp_n), c(apsp_n), from(apsp_n), order;
+        vector<char> done(apsp_n);
+        for (int s = tid; s < apsp_n && !query_expired(); s += step)
         {
-            tmp2 = pre[tmp1];
-            path[++cnt] = tmp2;
-            tmp1 = tmp2;
+            for (int type = 0; type < 2; type++)
+            {
+                const vector<int> &wt = snap_wt[type];
+                fill(d.begin(), d.end(), 0x3f3f3f3f);
+                fill(done.begin(), done.end(), 0);
+                order.clear();
+
+                d[s] = 0, c[s] = 1, from[s] = s;
+                priority_queue<pii, vector<pii>, greater<pii>> que;
+                que.push({0, s});
+                while (!que.empty())
+                {
+                    auto now = que.top();
+                    que.pop();
+                    int now_dist = now.first, u = now.second;
+                    if (done[u])
+                        continue;
+                    done[u] = true;
+                    order.push_back(u);
+
+                    for (int k = snap_off[u]; k < snap_off[u + 1]; k++)
+                    {
+                        int j = snap_to[k];
+                        if (d[j] == now_dist + wt[k])
+                            c[j] += c[u];
+                        if (d[j] > now_dist + wt[k])
+                        {
+                            from[j] = u;
+                            d[j] = now_dist + wt[k];
+                            c[j] = c[u];
+                            que.push({d[j], j});
+                        }
+                    }
+                }
+
+                size_t row = (size_t)s * apsp_n;
+                for (int u : order)
+                {
+                    apsp_dist[type][row + u] = d[u];
+                    apsp_cnt[type][row + u] = c[u];
+                    apsp_pre[type][row + u] = from[u];
+                }
+            }
         }
-    }
-    for (int i = cnt; i >= 2; i--)
-        cout << path[i] << " -> ";
-    cout << path[1] << endl;
+    };
 
-    Sleep(1500);
-    return;
+    int threads = max(1u, thread::hardware_concurrency());
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++)
+        pool.emplace_back(work, t, threads);
+    for (auto &th : pool)
+        th.join();
+
+    if (!query_expired()) // ȡʱ,ѯ˻dijkstra
+        apsp_version = graph_version;
 }
 
-/****************ѯ·С·*****************
- * ѯ·С·
+/*****************޸ͼ¼ȫԴ·****************
+ * ģʽұѹʱ¼ȫԴ·
  *  
- *  ·
+ *  apsp_ͷȫֱ
  * ֵ void
- * ˵
+ * ˵ÿ޸,ʱûнֹʱ;
+ *           ޸ĺվʱ,ѯԶ˻dijkstra
  ************************************************************/
-void quert_count_dist_and_cost()
+void apsp_refresh()
 {
-    query_min_dist(1);
-    cout << "·: " << cnt[ed_min_dist] << "" << endl;
-    query_min_cost();
-    cout << "ٻ·: " << cnt[ed_min_dist] << "" << endl;
-    Sleep(1500);
+    if (!apsp_enabled || apsp_version == graph_version)
+        return;
+    snap_build();
+    if (snap_n <= APSP_MAX)
+        apsp_build();
 }
 
-/*************Сת*********************
- * Сת
- *  յ
- *  תԼ·
+/*****************ش·*********************
+ * ʹȫԴ·ش̾/С
+ *  ,յ,(0Ϊ,1Ϊ)
+ *  dist[ed],cnt[ed]Լ·ϵpre,dijkstraĽͬ
+ * ֵ true-Ѳش  false-δѹ,Ҫdijkstra
+ * ˵ѯдӲ,޸֮apsp_refresh()
+ ************************************************************/
+bool apsp_query(int st, int ed, int type)
+{
+    if (!apsp_enabled || apsp_version != graph_version)
+        return false;
+    if (st < 0 || st >= N || ed < 0 || ed >= N || snap_id[st] == -1 || snap_id[ed] == -1)
+        return false;
+
+    int s = snap_id[st], t = snap_id[ed];
+    size_t row = (size_t)s * apsp_n;
+    dist[ed] = apsp_dist[type][row + t];
+    cnt[ed] = apsp_cnt[type][row + t];
+    if (dist[ed] >= 0x3f3f3f3f / 2)
+        return true;
+
+    // Ϊ·յ,preԱ·
+    for (int v = t; v != s;)
+    {
+        int u = apsp_pre[type][row + v];
+        pre[snap_station[v]] = snap_station[u];
+        v = u;
+    }
+    return true;
+}
+
+/**************ԤǰֹĶdijkstra*****************
+ * ɸ,ҳ򻨷ѲԤվ
+ *  㼯,(0Ϊ,1Ϊ),Ԥ
+ *  reached˳򴢴(վ,򻨷)
  * ֵ void
- * ˵
+ * ˵ѶԤʱ,ֻñηʹվ,
+ *           Ҫdijkstra_distdist
  ************************************************************/
-void get_min_change()
+void bounded_search(const vector<int> &sources, int type, int budget, vector<pii> &reached)
 {
-    // ʹù Bfs
-    memset(vis_bus, false, sizeof vis_bus);
-    queue<pii> que;
-    cout << "ѯյ: ";
-    cin >> min_change_st >> min_change_ed;
-    que.push({0, min_change_st});
+    if (!iso_init)
+    {
+        memset(iso_dist, 0x3f, sizeof iso_dist);
+        iso_init = true;
+    }
+    for (int u : iso_touched)
+        iso_dist[u] = 0x3f3f3f3f, iso_vis[u] = false;
+    iso_touched.clear();
+    reached.clear();
 
-    dijkstra_dist(min_change_st);
-    if (dist[min_change_ed] >= 0x3f3f3f3f / 2)
+    priority_queue<pii, vector<pii>, greater<pii>> que;
+    for (int st : sources)
     {
-        cout << endl
-             << "޷!" << endl
-             << endl;
-        Sleep(1500);
-        return;
+        if (st < 0 || st >= N || iso_dist[st] == 0)
+            continue;
+        iso_dist[st] = 0;
+        iso_touched.push_back(st);
+        que.push({0, st});
     }
 
     while (!que.empty())
     {
-        pii now = que.front();
+        if (query_tick()) // ʱĻ,ѾѵվȻȷ
+            break;
+        auto now = que.top();
         que.pop();
-        int step = now.first, stop = now.second;
-        vis_bus[stop] = true;
+        int now_dist = now.first, now_id = now.second;
+        if (now_dist > budget) // ֮ѵֻ,ֱӽ
+            break;
+        if (iso_vis[now_id])
+            continue;
+        iso_vis[now_id] = true;
+        reached.push_back({now_id, now_dist});
 
-        for (int i = h[stop]; ~i; i = ne[i])
+        for (int i = h[now_id]; ~i; i = ne[i])
         {
             int j = e[i];
             if (j == -1)
                 continue;
-            if (!vis_bus[j])
+            int nd = now_dist + (type ? w[i] : dis[i]);
+            if (nd <= budget && iso_dist[j] > nd)
             {
-                que.push({step + 1, j});
-                pre[j] = stop;
-
-                if (j == min_change_ed)
-                {
-                    cout << "ҪСתΪ: " << step << endl;
-                    goto next;
-                }
+                if (iso_dist[j] == 0x3f3f3f3f)
+                    iso_touched.push_back(j);
+                iso_dist[j] = nd;
+                que.push({nd, j});
             }
         }
     }
+}
 
-next:;
-    int tmp1, tmp2, cnt = 1;
-    path[1] = min_change_ed;
+/*****************ͶӰվ******************************
+ * վƽγΪ׼,ѾγȵȾͶӰΪƽ()
+ *  
+ *  geo_x,geo_yԼgeo_lat0
+ * ֵ void
+ * ˵зΧС;֮о붼ƽϼ,
+ *           ǲʽ,õ½һµ
+ ************************************************************/
+void geo_project()
+{
+    const double R = 6371000, RAD = acos(-1.0) / 180;
+    double sum = 0;
+    geo_cnt = 0;
+    for (int i = 0; i < N; i++)
+        if (geo_has[i])
+            sum += geo_lat[i], geo_cnt++;
+    geo_lat0 = geo_cnt ? sum / geo_cnt * RAD : 0;
+    for (int i = 0; i < N; i++)
+        if (geo_has[i])
+        {
+            geo_x[i] = R * geo_lon[i] * RAD * cos(geo_lat0);
+            geo_y[i] = R * geo_lat[i] * RAD;
+        }
+    geo_stamp++;
+}
 
-    cout << "Сת·Ϊ: ";
-    for (int i = 0; !(tmp2 == min_change_st); ++i)
+/*******************************************
+ * վ,ÿƽԼվ
+ *  
+ *  grid_ͷȫֱ
+ * ֵ void
+ * ˵еվ(CSR),ûб仯ʱֱӸ
+ ************************************************************/
+void geo_grid_build()
+{
+    if (grid_stamp == geo_stamp)
+        return;
+    grid_stamp = geo_stamp;
+    grid_off.assign(2, 0), grid_item.clear();
+    grid_w = grid_h = 1, grid_cell = 1;
+    if (!geo_cnt)
+        return;
+
+    double x0 = 1e18, y0 = 1e18, x1 = -1e18, y1 = -1e18;
+    for (int i = 0; i < N; i++)
+        if (geo_has[i])
+            x0 = min(x0, geo_x[i]), y0 = min(y0, geo_y[i]), x1 = max(x1, geo_x[i]), y1 = max(y1, geo_y[i]);
+    grid_cell = max(1.0, sqrt(max(x1 - x0, 1.0) * max(y1 - y0, 1.0) / max(1, geo_cnt / 2)));
+    grid_x0 = x0, grid_y0 = y0;
+    grid_w = min(2048, (int)((x1 - x0) / grid_cell) + 1);
+    grid_h = min(2048, (int)((y1 - y0) / grid_cell) + 1);
+    grid_cell = max(grid_cell, max((x1 - x0) / grid_w, (y1 - y0) / grid_h) * (1 + 1e-9));
+
+    auto cell = [&](int i)
     {
-        if (i == 0)
-            tmp1 = min_change_ed;
-        else
+        int cx = min(grid_w - 1, (int)((geo_x[i] - grid_x0) / grid_cell));
+        int cy = min(grid_h - 1, (int)((geo_y[i] - grid_y0) / grid_cell));
+        return cy * grid_w + cx;
+    };
+    grid_off.assign(grid_w * grid_h + 1, 0);
+    for (int i = 0; i < N; i++)
+        if (geo_has[i])
+            grid_off[cell(i) + 1]++;
+    for (int c = 0; c < grid_w * grid_h; c++)
+        grid_off[c + 1] += grid_off[c];
+    grid_item.assign(geo_cnt, 0);
+    vector<int> fill(grid_off.begin(), grid_off.end() - 1);
+    for (int i = 0; i < N; i++)
+        if (geo_has[i])
+            grid_item[fill[cell(i)]++] = i;
+}
+
+/*****************ѯkվ*************************
+ * ҳƽһkվ
+ *  ƽx,y,k
+ *  resС󴢴(,վ)
+ * ֵ void
+ * ˵ڸӿʼһȦһȦɨ,ҵkҵkľ
+ *           һȦӵʱֹͣ
+ ************************************************************/
+void geo_nearest(double x, double y, int k, vector<pair<double, int>> &res)
+{
+    geo_grid_build();
+    res.clear();
+    if (k <= 0 || !geo_cnt)
+        return;
+
+    int cx = (int)floor((x - grid_x0) / grid_cell), cy = (int)floor((y - grid_y0) / grid_cell);
+    int first = max(max(-cx, cx - (grid_w - 1)), max(-cy, cy - (grid_h - 1)));
+    int last = max(max(cx, grid_w - 1 - cx), max(cy, grid_h - 1 - cy));
+    priority_queue<pair<double, int>> best; // ,ǰk
+
+    auto visit = [&](int i, int j)
+    {
+        if (i < 0 || i >= grid_w || j < 0 || j >= grid_h)
+            return;
+        for (int q = grid_off[j * grid_w + i]; q < grid_off[j * grid_w + i + 1]; q++)
         {
-            tmp2 = pre[tmp1];
-            path[++cnt] = tmp2;
-            tmp1 = tmp2;
+            int v = grid_item[q];
+            double d = hypot(geo_x[v] - x, geo_y[v] - y);
+            if ((int)best.size() < k)
+                best.push({d, v});
+            else if (d < best.top().first)
+                best.pop(), best.push({d, v});
         }
+    };
+
+    for (int r = max(first, 0); r <= last; r++)
+    {
+        if ((int)best.size() == k && best.top().first <= (r - 1) * grid_cell)
+            break;
+        if (r == 0)
+            visit(cx, cy);
+        for (int d = -r; d <= r && r > 0; d++)
+            visit(cx + d, cy - r), visit(cx + d, cy + r);
+        for (int d = -r + 1; d <= r - 1; d++)
+            visit(cx - r, cy + d), visit(cx + r, cy + d);
     }
-    for (int i = cnt; i >= 2; i--)
-        cout << path[i] << "->";
-    cout << path[1] << endl;
 
-    Sleep(1500);
-    return;
+    while (!best.empty())
+        res.push_back(best.top()), best.pop();
+    reverse(res.begin(), res.end());
 }
 
-/***************鼯޸Ĳ************************
- * 鼯޸Ĳ
- * ޸ĵ
+/*****************ѯ뾶ڵվ**************************
+ * ҳƽһ㲻뾶վ
+ *  ƽx,y,뾶()
+ *  resС󴢴(,վ)
+ * ֵ void
+ * ˵ֻ뾶ཻĸ
+ ************************************************************/
+void geo_radius(double x, double y, double radius, vector<pair<double, int>> &res)
+{
+    geo_grid_build();
+    res.clear();
+    if (!geo_cnt)
+        return;
+    int i0 = max(0, (int)floor((x - radius - grid_x0) / grid_cell));
+    int i1 = min(grid_w - 1, (int)floor((x + radius - grid_x0) / grid_cell));
+    int j0 = max(0, (int)floor((y - radius - grid_y0) / grid_cell));
+    int j1 = min(grid_h - 1, (int)floor((y + radius - grid_y0) / grid_cell));
+    for (int j = j0; j <= j1; j++)
+        for (int i = i0; i <= i1; i++)
+            for (int q = grid_off[j * grid_w + i]; q < grid_off[j * grid_w + i + 1]; q++)
+            {
+                int v = grid_item[q];
+                double d = hypot(geo_x[v] - x, geo_y[v] - y);
+                if (d <= radius)
+                    res.push_back({d, v});
+            }
+    sort(res.begin(), res.end());
+}
+
+/*****************ֱ߾½Ƿ**********************
+ * жվǷ,·ξֱ߾Сֵ
+ *  
+ *  geo_scale
+ * ֵ true-ʹֱ߾½  false-վûֵΪ0
+ * ˵·ξĵλһ,ֵվֱ߾
+ *           ᳬ֮̾,½ǿɲһµ
+ ************************************************************/
+bool geo_ready()
+{
+    if (!geo_cnt)
+        return false;
+    if (geo_scale_version == graph_version && geo_scale_stamp == geo_stamp)
+        return geo_scale > 0;
+    geo_scale_version = graph_version, geo_scale_stamp = geo_stamp;
+
+    geo_scale = 1e18;
+    for (int u = 0; u < N && geo_scale > 0; u++)
+    {
+        if (h[u] == -1)
+            continue;
+        if (!geo_has[u])
+            geo_scale = 0;
+        for (int i = h[u]; ~i && geo_scale > 0; i = ne[i])
+        {
+            int j = e[i];
+            if (j == -1)
+                continue;
+            if (!geo_has[j])
+                geo_scale = 0;
+            else
+            {
+                double len = hypot(geo_x[u] - geo_x[j], geo_y[u] - geo_y[j]);
+                if (len > 0)
+                    geo_scale = min(geo_scale, dis[i] / len);
+            }
+        }
+    }
+    if (geo_scale >= 1e18) // վغ,½Ϊ0,û
+        geo_scale = 0;
+    return geo_scale > 0;
+}
+
+/*****************ֱ߾½******************************
+ * վֱ߾geo_scaleõ̾½
+ *  վv,յt
  *  
- * ֵ  ޸ĵx
- * ˵
+ * ֵ ½
+ * ˵ȡ΢С,⸡ʹ½糬ʵ
  ************************************************************/
-int find(int x)
+int geo_bound(int v, int t)
 {
-    if (x != p[x])
-        p[x] = find(p[x]);
-    return p[x];
+    return (int)(hypot(geo_x[v] - geo_x[t], geo_y[v] - geo_y[t]) * geo_scale * (1 - 1e-9));
 }
 
-/****************ѯС***************
- * ѯжٳվʻվ
- * 
+/*****************ϣϵλ******************
+ * վ65536x65536ϣϵ
+ *  վ
  *  
- * ֵ 
- * ˵
+ * ֵ ,ƽվҲ
+ * ˵ڰվ±
  ************************************************************/
-void query_last_number()
+long long geo_hilbert(int v)
 {
-    int cnt = 0, u_cnt = 0;
-    Edge edge[N];
-    for (auto bus_ : bus_line)
-        p[bus_] = bus_;
-    for (auto bus_ : bus_line)
+    geo_grid_build();
+    double span = max(grid_w, grid_h) * grid_cell;
+    long long x = min(65535.0, (geo_x[v] - grid_x0) / span * 65536);
+    long long y = min(65535.0, (geo_y[v] - grid_y0) / span * 65536);
+    long long d = 0;
+    for (long long s = 32768; s > 0; s >>= 1)
+    {
+        int rx = (x & s) > 0, ry = (y & s) > 0;
+        d += s * s * ((3 * rx) ^ ry);
+        if (ry == 0)
+        {
+            if (rx == 1)
+                x = s - 1 - x, y = s - 1 - y;
+            swap(x, y);
+        }
+    }
+    return d;
+}
+
+/*****************ֲԶվ±**********************
+ * BFS,Cuthill-McKee(RCM)ϣ˳վ±,ؽڽӱ
+ *  ŷʽ(1ΪBFS,2ΪRCM,3Ϊϣ,Ҫվ㶼)
+ *  µh,e,ne,w,dis,Լto_inner,to_outerӦϵ
+ * ֵ void
+ * ˵ڵվ,dist[j]ķʸ,ʸ;
+ *           ؽʱ߰С˵±μ,±
+ ************************************************************/
+void reorder_stations(int mode)
+{
+    vector<int> stations;
+    for (int i = 0; i < N; i++)
+        if (h[i] != -1)
+            stations.push_back(i);
+
+    // ͳÿվ㵱ǰĶ,RCMСչ
+    vector<int> deg(N, 0);
+    for (int u : stations)
+        for (int i = h[u]; ~i; i = ne[i])
+            if (e[i] != -1)
+                deg[u]++;
+
+    vector<int> order;
+    vector<char> seen(N, 0);
+    vector<int> roots = stations;
+    if (mode == 2)
+        stable_sort(roots.begin(), roots.end(), [&](int a, int b)
+                    { return deg[a] < deg[b]; });
+
+    if (mode == 3)
+    {
+        vector<long long> key(N, 0);
+        for (int u : stations)
+            key[u] = geo_hilbert(u);
+        order = stations;
+        stable_sort(order.begin(), order.end(), [&](int a, int b)
+                    { return key[a] < key[b]; });
+    }
+
+    for (int root : roots)
+    {
+        if (mode == 3)
+            break;
+        if (seen[root])
+            continue;
+        size_t head = order.size();
+        order.push_back(root);
+        seen[root] = true;
+        while (head < order.size())
+        {
+            int u = order[head++];
+            size_t from = order.size();
+            for (int i = h[u]; ~i; i = ne[i])
+            {
+                int j = e[i];
+                if (j != -1 && !seen[j])
+                {
+                    seen[j] = true;
+                    order.push_back(j);
+                }
+            }
+            if (mode == 2)
+                stable_sort(order.begin() + from, order.end(), [&](int a, int b)
+                            { return deg[a] < deg[b]; });
+        }
+    }
+    if (mode == 2)
+        reverse(order.begin(), order.end());
+
+    // ±Ŵ1ʼ,0űڵվ
+    vector<int> new_id(N, 0), old_outer(N);
+    for (int i = 0; i < N; i++)
+        old_outer[i] = out_id(i);
+    for (size_t k = 0; k < order.size(); k++)
+        new_id[order[k]] = k + 1;
+    for (auto &c : csa_conn) // ֻʱ̱гֵվ,ܶ
+        for (int u : {c.dep_stop, c.arr_stop})
+            if (!new_id[u])
+            {
+                order.push_back(u);
+                new_id[u] = order.size();
+            }
+
+    // ȡδɾ·,ߵ± i  i^1
+    struct Segment
+    {
+        int u, v, c, d, prof;
+    };
+    vector<Segment> segments;
+    for (int i = 0; i + 1 < idx; i += 2)
+    {
+        if (e[i] == -1)
+            continue;
+        int u = new_id[e[i + 1]], v = new_id[e[i]];
+        segments.push_back({u, v, w[i], dis[i], td_prof[i]});
+    }
+    stable_sort(segments.begin(), segments.end(), [](const Segment &a, const Segment &b)
+                { return min(a.u, a.v) < min(b.u, b.v); });
+
+    memset(h, -1, sizeof h);
+    idx = 0;
+    comp_reset();
+    for (auto &seg : segments)
+    {
+        add(seg.u, seg.v, seg.c, seg.d), add(seg.v, seg.u, seg.c, seg.d);
+        td_prof[idx - 2] = td_prof[idx - 1] = seg.prof;
+    }
+
+    StationSet new_bus;
+    for (int i = 0; i < N; i++)
+        if (bus[i] && new_id[i])
+            new_bus[new_id[i]] = true;
+    bus.swap(new_bus);
+    for (auto &bus_ : bus_line)
+        bus_ = new_id[bus_];
+
+    // վһƶ,ûбߵվ궪
+    vector<double> lat(N), lon(N);
+    vector<char> has(N, 0);
+    for (int i = 0; i < N; i++)
+        if (geo_has[i] && new_id[i])
+            lat[new_id[i]] = geo_lat[i], lon[new_id[i]] = geo_lon[i], has[new_id[i]] = true;
+    for (int i = 0; i < N; i++)
+        geo_lat[i] = lat[i], geo_lon[i] = lon[i], geo_has[i] = has[i];
+    geo_project();
+
+    // ʱ̱еվҲҪ±;ֻʱ,˳򲻱
+    for (auto &c : csa_conn)
+        c.dep_stop = new_id[c.dep_stop], c.arr_stop = new_id[c.arr_stop];
+
+    // ƺͱҲվƶ,ϣַֻй,Ҫؽ
+    vector<int> name(N, 0), code(N, 0);
+    for (int i = 0; i < N; i++)
+        if (new_id[i])
+            name[new_id[i]] = dict_name[i], code[new_id[i]] = dict_code[i];
+    for (auto &item : dict_keys)
+        item.station = new_id[item.station];
+    for (int i = 0; i < N; i++)
+        dict_name[i] = name[i], dict_code[i] = code[i];
+
+    memset(to_inner, -1, sizeof to_inner);
+    memset(to_outer, -1, sizeof to_outer);
+    for (size_t k = 0; k < order.size(); k++)
+    {
+        int ext = old_outer[order[k]];
+        to_inner[ext] = k + 1;
+        to_outer[k + 1] = ext;
+    }
+    inner_cnt = order.size();
+    reordered = true;
+}
+
+/****************ģ⻺ͳdijkstraĻȱʧ****************
+ * һdijkstra_dist,32KBֱӳ仺ģͳƻȱʧ
+ *  
+ *  
+ * ֵ ȱʧ
+ * ˵ʵַ64ֽڻģh,e,ne,dis,distķ
+ ************************************************************/
+long long count_cache_miss(int st)
+{
+    const int LINES = 512;
+    vector<uintptr_t> cache(LINES, 0);
+    long long miss = 0;
+    auto touch = [&](const void *addr)
+    {
+        uintptr_t line = (uintptr_t)addr >> 6;
+        if (cache[line % LINES] != line)
+        {
+            cache[line % LINES] = line;
+            miss++;
+        }
+    };
+
+    memset(dist, 0x3f, sizeof dist);
+    memset(vis, false, sizeof vis);
+    dist[st] = 0;
+    priority_queue<pii, vector<pii>, greater<pii>> que;
+    que.push({0, st});
+    while (!que.empty())
+    {
+        auto now = que.top();
+        que.pop();
+        int now_dist = now.first, now_id = now.second;
+        touch(&vis[now_id]);
+        if (vis[now_id])
+            continue;
+        vis[now_id] = true;
+
+        touch(&h[now_id]);
+        for (int i = h[now_id]; ~i; i = ne[i])
+        {
+            touch(&e[i]), touch(&ne[i]), touch(&dis[i]);
+            int j = e[i];
+            if (j == -1)
+                continue;
+            touch(&dist[j]);
+            if (dist[j] > now_dist + dis[i])
+            {
+                dist[j] = now_dist + dis[i];
+                que.push({dist[j], j});
+            }
+        }
+    }
+    return miss;
+}
+
+/*****************ѹڽӱ******************************
+ * ѿеڽӱѹɲֱ䳤ʽ
+ *  
+ *  cg_ͷȫֱ
+ * ֵ void
+ * ˵ÿվھӰֵ,ÿ7λһֽ,λʾ滹ֽ;
+ *           ͻѼȥСֵ,ȡֵΧѡ1,24ֽ,ʧ
+ ************************************************************/
+void cg_build()
+{
+    if (cg_version == graph_version)
+        return;
+    snap_build();
+
+    for (int type = 0; type < 2; type++)
+    {
+        int lo = 0, hi = 0;
+        if (!snap_wt[type].empty())
+        {
+            lo = *min_element(snap_wt[type].begin(), snap_wt[type].end());
+            hi = *max_element(snap_wt[type].begin(), snap_wt[type].end());
+        }
+        unsigned int range = (unsigned int)hi - (unsigned int)lo;
+        cg_base[type] = lo;
+        cg_width[type] = range < (1u << 8) ? 1 : range < (1u << 16) ? 2 : 4;
+        cg_wt[type].clear();
+    }
+
+    cg_node_off.assign(snap_n + 1, 0);
+    cg_edge_off.assign(snap_n + 1, 0);
+    cg_bytes.clear();
+
+    auto put_varint = [&](unsigned int x)
+    {
+        while (x >= 0x80)
+        {
+            cg_bytes.push_back((x & 0x7f) | 0x80);
+            x >>= 7;
+        }
+        cg_bytes.push_back(x);
+    };
+
+    vector<int> ord;
+    for (int u = 0; u < snap_n; u++)
+    {
+        cg_node_off[u] = cg_bytes.size();
+        cg_edge_off[u] = snap_off[u];
+
+        ord.clear();
+        for (int k = snap_off[u]; k < snap_off[u + 1]; k++)
+            ord.push_back(k);
+        sort(ord.begin(), ord.end(), [](int a, int b)
+             { return snap_to[a] < snap_to[b]; });
+
+        // һھӴԼ֮(zigzag),֮ǰһھӵĲ
+        int last = u;
+        for (size_t t = 0; t < ord.size(); t++)
+        {
+            int v = snap_to[ord[t]];
+            if (t == 0)
+            {
+                int diff = v - u;
+                put_varint(diff >= 0 ? (unsigned int)diff << 1 : ((unsigned int)(-diff) << 1) - 1);
+            }
+            else
+                put_varint(v - last);
+            last = v;
+
+            for (int type = 0; type < 2; type++)
+            {
+                unsigned int x = (unsigned int)snap_wt[type][ord[t]] - (unsigned int)cg_base[type];
+                for (int b = 0; b < cg_width[type]; b++)
+                    cg_wt[type].push_back((x >> (8 * b)) & 0xff);
+            }
+        }
+    }
+    cg_node_off[snap_n] = cg_bytes.size();
+    cg_edge_off[snap_n] = snap_off[snap_n];
+    cg_bytes.shrink_to_fit(), cg_wt[0].shrink_to_fit(), cg_wt[1].shrink_to_fit();
+    cg_version = graph_version;
+}
+
+/**************ѹͼϼ㵥Դ·************************
+ * ѹͼdijkstra㵥Դ̾С
+ *  ,(0Ϊ,1Ϊ)
+ *  дdist,dijkstra_dist/dijkstra_costһ
+ * ֵ void
+ * ˵ھӱ߽ɳ,ҪȽѹͼ;
+ *           ʱȡʱֱӷ,distûн
+ ************************************************************/
+void dijkstra_compressed(int st, int type)
+{
+    cg_build();
+    memset(dist, 0x3f, sizeof dist);
+    if (st < 0 || st >= N || snap_id[st] == -1)
+    {
+        if (st >= 0 && st < N)
+            dist[st] = 0;
+        return;
+    }
+
+    vector<int> d(snap_n, 0x3f3f3f3f);
+    vector<char> done(snap_n, 0);
+    const unsigned char *bytes = cg_bytes.data(), *wt = cg_wt[type].data();
+    int width = cg_width[type], base = cg_base[type];
+
+    int s = snap_id[st];
+    d[s] = 0;
+    priority_queue<pii, vector<pii>, greater<pii>> que;
+    que.push({0, s});
+    while (!que.empty())
+    {
+        if (query_tick())
+            return;
+        auto now = que.top();
+        que.pop();
+        int now_dist = now.first, u = now.second;
+        if (done[u])
+            continue;
+        done[u] = true;
+
+        const unsigned char *p = bytes + cg_node_off[u];
+        int v = u;
+        for (unsigned int k = cg_edge_off[u]; k < cg_edge_off[u + 1]; k++)
+        {
+            unsigned int x = 0;
+            for (int shift = 0;; shift += 7)
+            {
+                unsigned char c = *p++;
+                x |= (unsigned int)(c & 0x7f) << shift;
+                if (!(c & 0x80))
+                    break;
+            }
+            if (k == cg_edge_off[u])
+                v = u + ((x & 1) ? -(int)((x + 1) >> 1) : (int)(x >> 1));
+            else
+                v += x;
+
+            const unsigned char *q = wt + (size_t)k * width;
+            unsigned int y = q[0];
+            if (width >= 2)
+                y |= (unsigned int)q[1] << 8;
+            if (width == 4)
+                y |= (unsigned int)q[2] << 16 | (unsigned int)q[3] << 24;
+            int nd = now_dist + (int)(y + (unsigned int)base);
+
+            if (d[v] > nd)
+            {
+                d[v] = nd;
+                que.push({nd, v});
+            }
+        }
+    }
+
+    for (int u = 0; u < snap_n; u++)
+        dist[snap_station[u]] = d[u];
+}
+
+/**************ɾ·κ޸ͨǩ********************
+ * ɾվ֮·κ,޸վͨıǩ
+ * ɾ·ε˵
+ * comp_p
+ * ֵ void
+ * ˵˽BFS,˵Ȼͨ,;
+ *           ԭֳ,߷ֱԸԵĶ˵Ϊ±ǩ
+ ************************************************************/
+void comp_repair(int a, int b)
+{
+    if (a == b || comp_find(a) != comp_find(b))
+        return;
+
+    int mark_a = ++comp_stamp, mark_b = ++comp_stamp;
+    vector<int> side[2] = {{a}, {b}};
+    size_t head[2] = {0, 0};
+    comp_mark[a] = mark_a, comp_mark[b] = mark_b;
+
+    bool split = false;
+    while (!split)
+    {
+        for (int t = 0; t < 2 && !split; t++)
+        {
+            if (head[t] == side[t].size())
+            {
+                split = true;
+                break;
+            }
+            int u = side[t][head[t]++];
+            for (int i = h[u]; ~i; i = ne[i])
+            {
+                int j = e[i];
+                if (j == -1)
+                    continue;
+                if (comp_mark[j] == (t ? mark_a : mark_b)) // 
+                    return;
+                if (comp_mark[j] != (t ? mark_b : mark_a))
+                {
+                    comp_mark[j] = t ? mark_b : mark_a;
+                    side[t].push_back(j);
+                }
+            }
+        }
+    }
+
+    // Ѿ,ߵBFS,ֱ´ǩ
+    for (int t = 0; t < 2; t++)
+    {
+        int mark = t ? mark_b : mark_a;
+        while (head[t] < side[t].size())
+        {
+            int u = side[t][head[t]++];
+            for (int i = h[u]; ~i; i = ne[i])
+            {
+                int j = e[i];
+                if (j != -1 && comp_mark[j] != mark)
+                {
+                    comp_mark[j] = mark;
+                    side[t].push_back(j);
+                }
+            }
+        }
+        for (int u : side[t])
+            comp_p[u] = side[t][0];
+    }
+}
+
+/*****************ڿϼ㵥Դ·***********************
+ * ڿյCSRڽӱdijkstra㵥Դ̾С
+ *  (±),(0Ϊ,1Ϊ)
+ *  dΪÿ±̾С
+ * ֵ void
+ * ˵ʹȫֵdist,Ԥз
+ ************************************************************/
+void snap_dijkstra(int s, int type, vector<int> &d)
+{
+    const vector<int> &wt = snap_wt[type];
+    d.assign(snap_n, 0x3f3f3f3f);
+    vector<char> done(snap_n, 0);
+    d[s] = 0;
+    priority_queue<pii, vector<pii>, greater<pii>> que;
+    que.push({0, s});
+    while (!que.empty())
+    {
+        auto now = que.top();
+        que.pop();
+        int now_dist = now.first, u = now.second;
+        if (done[u])
+            continue;
+        done[u] = true;
+        for (int k = snap_off[u]; k < snap_off[u + 1]; k++)
+        {
+            int j = snap_to[k];
+            if (d[j] > now_dist + wt[k])
+            {
+                d[j] = now_dist + wt[k];
+                que.push({d[j], j});
+            }
+        }
+    }
+}
+
+/*****************ALTرԤ******************************
+ * ѡɸر,ÿվ㵽ÿر̾С
+ *  (0Ϊ,1Ϊ)
+ *  alt_markalt_d
+ * ֵ void
+ * ˵رԶѡ: ÿѡѡرԶվ(ɴΪԶ,
+ *           ÿֵͨر);·ζ˫,
+ *           վ㵽رر굽վľͬ,ֻһ
+ ************************************************************/
+void alt_build(int type)
+{
+    snap_build();
+    int k = min(ALT_LANDMARKS, snap_n);
+    alt_mark[type].clear();
+    alt_d[type].assign((size_t)snap_n * ALT_LANDMARKS, 0x3f3f3f3f);
+    if (snap_n == 0)
+    {
+        alt_version[type] = graph_version;
+        return;
+    }
+
+    vector<int> d, nearest(snap_n, 0x3f3f3f3f);
+    snap_dijkstra(0, type, d);
+    int next = max_element(d.begin(), d.end(),
+                           [](int a, int b)
+                           { return (a >= 0x3f3f3f3f / 2 ? -1 : a) < (b >= 0x3f3f3f3f / 2 ? -1 : b); }) -
+               d.begin();
+
+    for (int l = 0; l < k; l++)
+    {
+        if (query_expired()) // ѯдԤʱ,alt_version
+            return;
+        alt_mark[type].push_back(next);
+        snap_dijkstra(next, type, d);
+        for (int v = 0; v < snap_n; v++)
+        {
+            alt_d[type][(size_t)v * ALT_LANDMARKS + l] = d[v];
+            nearest[v] = min(nearest[v], d[v]);
+        }
+        next = max_element(nearest.begin(), nearest.end()) - nearest.begin();
+        if (nearest[next] == 0) // վ㶼Ѿǵر
+            break;
+    }
+    alt_version[type] = graph_version;
+}
+
+/*****************ALTǷʹ*****************************
+ * жALTǷ,ͼ޸ĹʱԤ
+ *  (0Ϊ,1Ϊ)
+ *  
+ * ֵ true-ʹALT½
+ * ˵ӱ߻ɾߺɵ½粻ٿɿ,¼;¼㳬ʱʱʹ
+ ************************************************************/
+bool alt_ready(int type)
+{
+    if (!alt_enabled)
+        return false;
+    if (alt_version[type] != graph_version)
+        alt_build(type);
+    return alt_version[type] == graph_version;
+}
+
+/*****************ALT½ۺ*****************************
+ * ǲʽvtľ򻨷ѵ½
+ *  վv,յt,(0Ϊ,1Ϊ)
+ *  
+ * ֵ ½,ÿرLȡ |d(L,t)-d(L,v)| ֵ
+ * ˵vtͨʱ
+ ************************************************************/
+int alt_bound(int v, int t, int type)
+{
+    if (v < 0 || v >= N || t < 0 || t >= N || snap_id[v] == -1 || snap_id[t] == -1)
+        return 0;
+    const int *dv = &alt_d[type][(size_t)snap_id[v] * ALT_LANDMARKS];
+    const int *dt = &alt_d[type][(size_t)snap_id[t] * ALT_LANDMARKS];
+    int best = 0;
+    for (size_t l = 0; l < alt_mark[type].size(); l++)
+    {
+        bool inf_v = dv[l] >= 0x3f3f3f3f / 2, inf_t = dt[l] >= 0x3f3f3f3f / 2;
+        if (inf_v != inf_t)
+            return 0x3f3f3f3f;
+        if (!inf_v)
+            best = max(best, abs(dt[l] - dv[l]));
+    }
+    return best;
+}
+
+/*****************Ŀ굼ĵ㵽ѯ**********************
+ * ʹALT½ֱ߾½ΪۺA*㷨̾С
+ *  ,յ,(0Ϊ,1Ϊ)
+ *  dist[ed]Լ·ϵpre,dijkstraĽͬ
+ * ֵ true-ѻش  false-½綼,Ҫdijkstra
+ * ˵ʹALT,ֱ߾½ֻھ;յѼ,ֻñηʹվ
+ ************************************************************/
+bool goal_query(int st, int ed, int type)
+{
+    bool use_alt = alt_ready(type);
+    if (!use_alt && !(type == 0 && geo_ready()))
+        return false;
+    auto bound = [&](int v)
+    {
+        return use_alt ? alt_bound(v, ed, type) : geo_bound(v, ed);
+    };
+
+    static vector<int> g, touched;
+    static vector<char> done;
+    if ((int)g.size() != N)
+        g.assign(N, 0x3f3f3f3f), done.assign(N, 0);
+    for (int u : touched)
+        g[u] = 0x3f3f3f3f, done[u] = 0;
+    touched.clear();
+
+    g[st] = 0;
+    touched.push_back(st);
+    priority_queue<pii, vector<pii>, greater<pii>> que; // (g+½, վ)
+    que.push({bound(st), st});
+    while (!que.empty())
+    {
+        if (query_tick())
+            break;
+        int u = que.top().second;
+        que.pop();
+        if (done[u])
+            continue;
+        done[u] = true;
+        if (u == ed)
+            break;
+        for (int i = h[u]; ~i; i = ne[i])
+        {
+            int j = e[i];
+            if (j == -1)
+                continue;
+            int nd = g[u] + (type ? w[i] : dis[i]);
+            if (g[j] > nd)
+            {
+                if (g[j] == 0x3f3f3f3f)
+                    touched.push_back(j);
+                g[j] = nd;
+                pre[j] = u;
+                int f = bound(j);
+                if (f < 0x3f3f3f3f / 2)
+                    que.push({nd + f, j});
+            }
+        }
+    }
+    dist[ed] = g[ed];
+    return true;
+}
+
+/*****************A-star㷨k̾**********************
+ * A-star㷨k̾
+ *  ,յ,k
+ *  
+ * ֵ void
+ * ˵ۺʹALTر½,ֱ߾½,ʱҪԤܷdijkstra;
+ *           ʱȡʱfalse,A_star_distѾҵǰ·
+ ************************************************************/
+bool A_star(int st, int ed, int k)
+{
+    int num = 0, check = 0;
+    A_star_dist.clear();
+    if (st == ed)
+        k++;
+
+    if (!comp_connected(st, ed))
+        return false;
+
+    // ALTʱõر½Ϊۺ,ֱ߾½,ʹ÷dijkstraõdist
+    bool use_alt = alt_ready(0), use_geo = !use_alt && geo_ready();
+    auto estimate = [&](int v)
+    {
+        return use_alt ? alt_bound(v, ed, 0) : use_geo ? geo_bound(v, ed) : dist[v];
+    };
+
+    priority_queue<node> que;
+    que.push(node(st, 0, estimate(st)));
+    vector<int> expand(N, 0); // ÿվѾѵĴ
+
+    while (!que.empty())
+    {
+        if (query_tick()) // ʱȡ,A_star_distбѾҵ·
+            return false;
+        node now = que.top();
+        que.pop();
+
+        // ۺһʱͬһվ㰴gС,kԺѵ·ǰk
+        if (++expand[now.pos] > k)
+            continue;
+
+        // A_star_path[num].push_back(now.pos);
+        if (now.pos == ed)
+        {
+            check = 1;
+            num++;
+            A_star_dist.push_back(now.g);
+            // A_star_path[num].push_back(st);
+        }
+        if (num == k)
+            return true;
+        for (int i = h[now.pos]; ~i; i = ne[i])
+        {
+            node nex;
+
+            if (e[i] == -1)
+                continue;
+
+            nex.pos = e[i];
+            nex.g = now.g + dis[i];
+            // cout<<e[i]<<' '<<dis[i]<<' '<<nex.g<<endl;
+            nex.f = (now.g + dis[i]) + estimate(e[i]);
+            que.push(nex);
+        }
+    }
+    return false;
+}
+
+/***********************************************
+ * Ҫվ,Ҫʱݾ,(CH)
+ *  (0Ϊ,1Ϊ)
+ *  ch_posԼλôŵϱ
+ * ֵ void
+ * ˵˳ñ߲(ҪĽݾ-+ھ)ӳٸ:
+ *           ֻھӱվʱ¹,˾ͷŻض;
+ *           ֤Ƴվ;·,ȼʱøС,
+ *           Ҳ֤ʱһݾ,Ӱȷ;ʣµվ
+ *           CH_CORE_DEGREEʱֻݾ,Щվ㲻Ϊ
+ *           ڲ㼶ߴ,ڵı򶼵ϱ;
+ *           ʱȡʱֱӷ,ch_version
+ ************************************************************/
+void ch_build(int type)
+{
+    snap_build();
+    int V = snap_n;
+
+    // ȥر(СȨֵ)Ի
+    vector<vector<pii>> adj(V);
+    for (int u = 0; u < V; u++)
+    {
+        for (int k = snap_off[u]; k < snap_off[u + 1]; k++)
+            if (snap_to[k] != u)
+                adj[u].push_back({snap_to[k], snap_wt[type][k]});
+        sort(adj[u].begin(), adj[u].end());
+        adj[u].erase(unique(adj[u].begin(), adj[u].end(), [](const pii &a, const pii &b)
+                            { return a.first == b.first; }),
+                     adj[u].end());
+    }
+
+    vector<char> contracted(V, 0), dirty(V, 0);
+    vector<int> rank(V, 0), removed(V, 0);
+    vector<int> wd(V, 0x3f3f3f3f), hops(V, 0), touched;
+    vector<int> target(V, -1); // stampʱʾҪҼ֤վ
+    int stamp = 0, left = 0;   // ı,ûгѵĿվ
+
+    // src,skipվ,Ҿ벻limitվ;
+    // max_settledվ,ྭmax_hops·,Ŀվ㶼Ѻǰ
+    auto witness = [&](int src, int skip, int limit, int max_settled, int max_hops)
+    {
+        for (int u : touched)
+            wd[u] = 0x3f3f3f3f;
+        touched.clear();
+        wd[src] = 0, hops[src] = 0;
+        touched.push_back(src);
+        priority_queue<pii, vector<pii>, greater<pii>> que;
+        que.push({0, src});
+        int settled = 0;
+        while (!que.empty() && settled < max_settled)
+        {
+            auto now = que.top();
+            que.pop();
+            if (now.first > limit)
+                break;
+            if (now.first > wd[now.second])
+                continue;
+            settled++;
+            if (target[now.second] == stamp && --left == 0)
+                break;
+            if (hops[now.second] >= max_hops)
+                continue;
+            for (auto &nb : adj[now.second])
+            {
+                int j = nb.first, nd = now.first + nb.second;
+                if (j == skip || contracted[j] || wd[j] <= nd)
+                    continue;
+                if (wd[j] == 0x3f3f3f3f)
+                    touched.push_back(j);
+                wd[j] = nd, hops[j] = hops[now.second] + 1;
+                que.push({nd, j});
+            }
+        }
+    };
+
+    auto add_shortcut = [&](int u, int x, int len)
+    {
+        for (auto &nb : adj[u])
+            if (nb.first == x)
+            {
+                nb.second = min(nb.second, len);
+                return;
+            }
+        adj[u].push_back({x, len});
+    };
+
+    // vҪĽݾ,applyΪtrueʱ,ֻýСƹ
+    vector<pii> nbs;
+    auto contract = [&](int v, bool apply)
+    {
+        nbs.clear();
+        for (auto &nb : adj[v])
+            if (!contracted[nb.first])
+                nbs.push_back(nb);
+        int max_out = 0;
+        for (auto &nb : nbs)
+            max_out = max(max_out, nb.second);
+
+        int need = 0;
+        for (size_t a = 0; a + 1 < nbs.size(); a++)
+        {
+            stamp++;
+            for (size_t b = a + 1; b < nbs.size(); b++)
+                target[nbs[b].first] = stamp;
+            left = nbs.size() - a - 1;
+            if (apply)
+                witness(nbs[a].first, v, nbs[a].second + max_out, 100, 5);
+            else
+                witness(nbs[a].first, v, nbs[a].second + max_out, 20, 2);
+            for (size_t b = a + 1; b < nbs.size(); b++)
+            {
+                int len = nbs[a].second + nbs[b].second;
+                if (wd[nbs[b].first] <= len)
+                    continue;
+                need++;
+                if (apply)
+                    add_shortcut(nbs[a].first, nbs[b].first, len), add_shortcut(nbs[b].first, nbs[a].first, len);
+            }
+        }
+        return make_pair(need, (int)nbs.size());
+    };
+
+    auto priority_of = [&](int v)
+    {
+        auto res = contract(v, false);
+        return res.first - res.second + removed[v];
+    };
+
+    priority_queue<pii, vector<pii>, greater<pii>> que;
+    for (int v = 0; v < V; v++)
+    {
+        if (query_expired()) // ʱȡʱ,ch_version,´½
+            return;
+        que.push({priority_of(v), v});
+    }
+
+    int order = 0, shortcuts = 0;
+    vector<char> core(V, 0);
+    while (!que.empty())
+    {
+        if (query_expired())
+            return;
+        int v = que.top().second;
+        que.pop();
+        if (contracted[v])
+            continue;
+        if (dirty[v]) // ӳٸ: ھӱ¹,ȼ˾ͷŻȥ
+        {
+            dirty[v] = false;
+            int pr = priority_of(v);
+            if (!que.empty() && pr > que.top().first)
+            {
+                que.push({pr, v});
+                continue;
+            }
+        }
+        if ((int)adj[v].size() > CH_CORE_DEGREE) // ȼСվҲ,ʣµĶΪ
+        {
+            for (int u = 0; u < V; u++)
+                if (!contracted[u])
+                    core[u] = true, rank[u] = order++;
+            break;
+        }
+        shortcuts += contract(v, true).first;
+        contracted[v] = true;
+        rank[v] = order++;
+        // ϱֻӲ㼶͵һȡ,vӻûھɾ,֮ļ֤
+        for (auto &nb : adj[v])
+        {
+            if (contracted[nb.first])
+                continue;
+            removed[nb.first]++, dirty[nb.first] = true;
+            auto &list = adj[nb.first];
+            for (size_t k = 0; k < list.size(); k++)
+                if (list[k].first == v)
+                {
+                    list[k] = list.back(), list.pop_back();
+                    break;
+                }
+        }
+    }
+
+    // 㼶Ӹߵ,㼶ߵվλΪ0
+    vector<int> &pos = ch_pos[type];
+    pos.assign(V, 0);
+    for (int v = 0; v < V; v++)
+        pos[v] = V - 1 - rank[v];
+
+    vector<vector<pii>> up(V);
+    for (int v = 0; v < V; v++)
+        for (auto &nb : adj[v])
+            if (rank[nb.first] > rank[v] || (core[v] && core[nb.first]))
+                up[pos[v]].push_back({pos[nb.first], nb.second});
+
+    ch_off[type].assign(V + 1, 0);
+    ch_to[type].clear(), ch_w[type].clear();
+    for (int p = 0; p < V; p++)
+    {
+        sort(up[p].begin(), up[p].end());
+        for (auto &nb : up[p])
+            ch_to[type].push_back(nb.first), ch_w[type].push_back(nb.second);
+        ch_off[type][p + 1] = ch_to[type].size();
+    }
+    ch_shortcuts[type] = shortcuts;
+    ch_version[type] = graph_version;
+}
+
+/*****************PHASTһԶ·**********************
+ * ʹPHASTһμPHAST_LANES㵽վ̾С
+ *  (±),(0Ϊ,1Ϊ)
+ *  d λ*PHAST_LANES+ڼ Ž
+ * ֵ void
+ * ˵ÿϱһκСdijkstra,ȻλôС
+ *           ɨһ,ò㼶ߵվԼ;ͬһ,
+ *           ڲԸѭûз֧,SIMDָм
+ ************************************************************/
+void phast_batch(const vector<int> &sources, int type, vector<int> &d)
+{
+    if (ch_version[type] != graph_version)
+        ch_build(type);
+    int V = snap_n;
+    const vector<int> &pos = ch_pos[type], &off = ch_off[type], &to = ch_to[type], &wt = ch_w[type];
+    d.assign((size_t)V * PHAST_LANES, 0x3f3f3f3f);
+
+    // 
+    for (size_t l = 0; l < sources.size() && l < (size_t)PHAST_LANES; l++)
+    {
+        priority_queue<pii, vector<pii>, greater<pii>> que;
+        int s = pos[sources[l]];
+        d[(size_t)s * PHAST_LANES + l] = 0;
+        que.push({0, s});
+        while (!que.empty())
+        {
+            auto now = que.top();
+            que.pop();
+            if (now.first > d[(size_t)now.second * PHAST_LANES + l])
+                continue;
+            for (int k = off[now.second]; k < off[now.second + 1]; k++)
+            {
+                int &target = d[(size_t)to[k] * PHAST_LANES + l];
+                if (target > now.first + wt[k])
+                {
+                    target = now.first + wt[k];
+                    que.push({target, to[k]});
+                }
+            }
+        }
+    }
+
+    // ɨ
+    int *row = d.data();
+    for (int p = 0; p < V; p++, row += PHAST_LANES)
+    {
+        for (int k = off[p]; k < off[p + 1]; k++)
+        {
+            const int *from = d.data() + (size_t)to[k] * PHAST_LANES;
+            int len = wt[k];
+            for (int l = 0; l < PHAST_LANES; l++)
+                row[l] = min(row[l], from[l] + len);
+        }
+    }
+}
+
+/*********************************************
+ * Brandes㷨ÿվÿ·α·
+ *  (0Ϊ,1Ϊ),(0Ϊȫվ)
+ *  station_bc±,segment_bc·α(±/2)
+ * ֵ ʵ
+ * ˵ÿһdijkstra,˳ͳ·,ٵۼֵ;
+ *           ֻȳѵվ㵱ǰ,0Ȩ·ʱҲظ;
+ *           ·double,int cnt[];㰴̷߳,
+ *           ÿ߳ۼӵԼ,ٺϲ;˳,
+ *           ʱǰʱʵȱŴ;
+ *           ·˫,ÿվ˸һ,2
+ ************************************************************/
+int betweenness(int type, int samples, vector<double> &station_bc, vector<double> &segment_bc)
+{
+    snap_build();
+    int V = snap_n, S = idx / 2 + 1;
+    const vector<int> &wt = snap_wt[type];
+
+    // ʱҲ,ʱǰʱǾȵ
+    vector<int> sources(V);
+    iota(sources.begin(), sources.end(), 0);
+    mt19937 rng(20240601);
+    shuffle(sources.begin(), sources.end(), rng);
+    if (samples > 0 && samples < V)
+        sources.resize(samples);
+
+    int threads = max(1u, thread::hardware_concurrency());
+    threads = min(threads, max(1, (int)sources.size()));
+    vector<vector<double>> part_station(threads, vector<double>(V, 0)), part_segment(threads, vector<double>(S, 0));
+    atomic<int> processed(0);
+
+    auto work = [&](int tid)
+    {
+        vector<double> &bc = part_station[tid], &ebc = part_segment[tid];
+        vector<int> d(V, 0x3f3f3f3f), pos(V, -1), order;
+        vector<double> sigma(V, 0), delta(V, 0);
+        for (size_t q = tid; q < sources.size(); q += threads)
+        {
+            if (query_expired()) // ʱֻѾ
+                break;
+            int s = sources[q];
+            for (int u : order)
+                d[u] = 0x3f3f3f3f, pos[u] = -1, sigma[u] = 0, delta[u] = 0;
+            order.clear();
+
+            d[s] = 0, sigma[s] = 1;
+            priority_queue<pii, vector<pii>, greater<pii>> que;
+            que.push({0, s});
+            while (!que.empty())
+            {
+                auto now = que.top();
+                que.pop();
+                int u = now.second;
+                if (pos[u] != -1 || now.first > d[u])
+                    continue;
+                pos[u] = order.size();
+                order.push_back(u);
+                for (int k = snap_off[u]; k < snap_off[u + 1]; k++)
+                {
+                    int j = snap_to[k], nd = d[u] + wt[k];
+                    if (pos[j] != -1)
+                        continue;
+                    if (d[j] > nd)
+                    {
+                        d[j] = nd, sigma[j] = 0;
+                        que.push({nd, j});
+                    }
+                    if (d[j] == nd)
+                        sigma[j] += sigma[u];
+                }
+            }
+
+            // ۼֵ,ǰȳ d[v]+w == d[u] վ(·˫,Ȩֵͬ)
+            for (int t = order.size() - 1; t > 0; t--)
+            {
+                int u = order[t];
+                double coef = (1 + delta[u]) / sigma[u];
+                for (int k = snap_off[u]; k < snap_off[u + 1]; k++)
+                {
+                    int v = snap_to[k];
+                    if (pos[v] == -1 || pos[v] >= pos[u] || d[v] + wt[k] != d[u])
+                        continue;
+                    double c = sigma[v] * coef;
+                    delta[v] += c;
+                    ebc[snap_eid[k] >> 1] += c;
+                }
+                bc[u] += delta[u];
+            }
+            processed++;
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++)
+        pool.emplace_back(work, t);
+    for (auto &th : pool)
+        th.join();
+
+    double scale = processed ? 0.5 * V / processed : 0;
+    station_bc.assign(V, 0), segment_bc.assign(S, 0);
+    for (int t = 0; t < threads; t++)
+    {
+        for (int v = 0; v < V; v++)
+            station_bc[v] += part_station[t][v] * scale;
+        for (int x = 0; x < S; x++)
+            segment_bc[x] += part_segment[t][x] * scale;
+    }
+    return processed;
+}
+
+/*****************ź͸******************************
+ * һDFSҳе(·)͸(վ),Լɾֵվ
+ *  
+ *  bridges(·α,Сһվ,һվ);
+ *           cuts(±,ɾվֵվ)
+ * ֵ void
+ * ˵ʽջݹ,·ܳʱҲջ;ڵʱ·α
+ *           (±/2)ж,վ֮ж·ʱᱻΪ;ʱ临ӶO(V+E)
+ ************************************************************/
+void find_cut_points(vector<array<int, 3>> &bridges, vector<pair<int, vector<int>>> &cuts)
+{
+    snap_build();
+    int V = snap_n, timer = 0;
+    vector<int> tin(V, -1), low(V, 0), sub(V, 1);
+    bridges.clear(), cuts.clear();
+
+    struct Frame
+    {
+        int u, k, parent_seg; // վ,һҪı,վ·
+    };
+    vector<Frame> stk;
+    vector<pii> pieces; // (վ,ɾȥһվ)
+    for (int root = 0; root < V; root++)
+    {
+        if (tin[root] != -1)
+            continue;
+        size_t first_bridge = bridges.size();
+        pieces.clear();
+        tin[root] = low[root] = timer++;
+        stk.push_back({root, snap_off[root], -1});
+        while (!stk.empty())
+        {
+            Frame &f = stk.back();
+            if (f.k < snap_off[f.u + 1])
+            {
+                int k = f.k++, j = snap_to[k], seg = snap_eid[k] >> 1;
+                if (seg == f.parent_seg)
+                    continue;
+                if (tin[j] != -1)
+                    low[f.u] = min(low[f.u], tin[j]);
+                else
+                {
+                    tin[j] = low[j] = timer++;
+                    stk.push_back({j, snap_off[j], seg});
+                }
+                continue;
+            }
+
+            // uб߶ѿ,صڵ
+            int u = f.u, seg = f.parent_seg;
+            stk.pop_back();
+            if (stk.empty())
+                continue;
+            int up = stk.back().u;
+            low[up] = min(low[up], low[u]);
+            sub[up] += sub[u];
+            if (low[u] > tin[up])
+                bridges.push_back({seg, sub[u], 0});
+            if (low[u] >= tin[up])
+                pieces.push_back({up, sub[u]});
+        }
+
+        // ͨվȷ,ȫһԼֵĴС
+        int total = sub[root];
+        for (size_t q = first_bridge; q < bridges.size(); q++)
+        {
+            auto &b = bridges[q];
+            b[2] = total - b[1];
+            if (b[1] > b[2])
+                swap(b[1], b[2]);
+        }
+        sort(pieces.begin(), pieces.end());
+        for (size_t q = 0; q < pieces.size();)
+        {
+            int u = pieces[q].first, rest = total - 1;
+            vector<int> parts;
+            for (; q < pieces.size() && pieces[q].first == u; q++)
+                parts.push_back(pieces[q].second), rest -= pieces[q].second;
+            if (rest > 0) // DFSʱ,ڵһҲһ
+                parts.push_back(rest);
+            if (parts.size() >= 2)
+            {
+                sort(parts.begin(), parts.end());
+                cuts.push_back({u, parts});
+            }
+        }
+    }
+}
+
+/*****************Ȩֵ·************************
+ * ڿϰıȨ㵽յdijkstra
+ *  յ(±),ÿձߵȨֵ
+ *  edges˳򴢴澭Ŀձ
+ * ֵ true-ҵ·  false-޷
+ * ˵յѼ;Ȩֵlong long,γͷҲ
+ ************************************************************/
+bool route_search(int s, int t, const vector<long long> &wt, vector<int> &edges)
+{
+    vector<long long> d(snap_n, LLONG_MAX);
+    vector<int> via(snap_n, -1), par(snap_n, -1);
+    priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<pair<long long, int>>> que;
+    d[s] = 0;
+    que.push({0, s});
+    while (!que.empty())
+    {
+        if (query_tick())
+            break;
+        auto now = que.top();
+        que.pop();
+        int u = now.second;
+        if (now.first > d[u])
+            continue;
+        if (u == t)
+            break;
+        for (int k = snap_off[u]; k < snap_off[u + 1]; k++)
+        {
+            int j = snap_to[k];
+            if (d[j] > now.first + wt[k])
+            {
+                d[j] = now.first + wt[k];
+                via[j] = k, par[j] = u;
+                que.push({d[j], j});
+            }
+        }
+    }
+
+    edges.clear();
+    if (d[t] == LLONG_MAX || query_expired())
+        return false;
+    for (int u = t; u != s; u = par[u])
+        edges.push_back(via[u]);
+    reverse(edges.begin(), edges.end());
+    return true;
+}
+
+/*****************ɱѡ·******************************
+ * óͷkԵ·
+ *  յ(ڲ),(0Ϊ,1Ϊ),·k
+ *  routesÿ·߾վ(ڲ),lengthsΪӦĳȻ򻨷
+ * ֵ true-ҵһ·  false-޷
+ * ˵ʱȡʱѾѡ·;̶ROUTE_ROUNDS,ÿΰҵ·ϵ·()
+ *           سͷ;ѡ·Ҫ: ·ߵROUTE_STRETCH,
+ *           ѡ·غϲROUTE_OVERLAP,вм䳤Ϊ
+ *           ROUTE_LOCAL·ߵһα·(bounded_search)
+ ************************************************************/
+bool alternative_routes(int st, int ed, int type, int k, vector<vector<int>> &routes, vector<int> &lengths)
+{
+    routes.clear(), lengths.clear();
+    snap_build();
+    if (st < 0 || st >= N || ed < 0 || ed >= N || snap_id[st] < 0 || snap_id[ed] < 0)
+        return false;
+    int s = snap_id[st], t = snap_id[ed];
+    const vector<int> &orig = snap_wt[type];
+
+    vector<int> twin(idx, -1); // ԭ± -> ձ±
+    for (size_t q = 0; q < snap_eid.size(); q++)
+        twin[snap_eid[q]] = q;
+    vector<long long> wt(orig.begin(), orig.end());
+
+    vector<set<int>> chosen; // ѡ·߾·(±/2)
+    vector<int> edges, prefix, nodes; // ·߾ı,վ㵽ĳ,վ
+    vector<pii> reached;
+    long long best = 0;
+    for (int r = 0; r < ROUTE_ROUNDS && (int)routes.size() < k; r++)
+    {
+        if (!route_search(s, t, wt, edges))
+            return query_expired() && !routes.empty();
+        if (edges.empty()) // յ
+        {
+            routes.push_back({st}), lengths.push_back(0);
+            return true;
+        }
+
+        prefix.assign(1, 0), nodes.assign(1, s);
+        for (int q : edges)
+            prefix.push_back(prefix.back() + orig[q]), nodes.push_back(snap_to[q]);
+        long long len = prefix.back();
+        if (r == 0)
+            best = len;
+
+        bool ok = len <= ROUTE_STRETCH * best;
+        for (auto &seg : chosen)
+        {
+            long long shared = 0;
+            for (int q : edges)
+                if (seg.count(snap_eid[q] >> 1))
+                    shared += orig[q];
+            if (shared > ROUTE_OVERLAP * len || shared == len)
+                ok = false;
+        }
+
+        // ֲż: ȡвֵе,ǰROUTE_LOCAL/2·,һα·
+        if (ok && r > 0)
+        {
+            int a = -1, b = -1;
+            for (int q = 0; q < (int)edges.size(); q++)
+                if (!chosen[0].count(snap_eid[edges[q]] >> 1))
+                {
+                    if (a == -1)
+                        a = q;
+                    b = q;
+                }
+            double mid = (prefix[a] + prefix[b + 1]) / 2.0, half = ROUTE_LOCAL * best / 2;
+            int x = 0, y = edges.size();
+            while (x + 1 < (int)edges.size() && prefix[x + 1] <= mid - half)
+                x++;
+            while (y > x + 1 && prefix[y - 1] >= mid + half)
+                y--;
+            bounded_search({snap_station[nodes[x]]}, type, prefix[y] - prefix[x], reached);
+            // ֹʱʱiso_distܻ̾,ܾݴ˽ܺѡ·
+            ok = !query_expired() && iso_dist[snap_station[nodes[y]]] == prefix[y] - prefix[x];
+        }
+
+        if (ok)
+        {
+            vector<int> path;
+            for (int u : nodes)
+                path.push_back(snap_station[u]);
+            routes.push_back(path), lengths.push_back(len);
+            chosen.push_back({});
+            for (int q : edges)
+                chosen.back().insert(snap_eid[q] >> 1);
+        }
+
+        for (int q : edges) // ͷ·ϵ·,һ
+        {
+            long long extra = max(1LL, (long long)(orig[q] * ROUTE_PENALTY));
+            wt[q] += extra;
+            int back = twin[snap_eid[q] ^ 1];
+            if (back != -1)
+                wt[back] += extra;
+        }
+    }
+    return true;
+}
+
+/*****************·εľ̬ʻʱ************************
+ * ƽٰѵiߵľ뻻Ϊʻʱ
+ *  ߵ±
+ *  
+ * ֵ ʻʱ(),ȡ
+ * ˵disĵλ,ʱѯʱĵλǷ
+ ************************************************************/
+int td_static(int i)
+{
+    return (dis[i] + TD_SPEED - 1) / TD_SPEED;
+}
+
+/*****************·εʻʱ************************
+ * iڳʱtʻʱ
+ *  ߵ±,ʱ(,Գһ)
+ *  
+ * ֵ ʻʱ()
+ * ˵߰ѭ,ϵ֮Բֵ;ûߵıʹtd_static()
+ ************************************************************/
+int td_travel(int i, int t)
+{
+    int k = td_prof[i];
+    if (!k)
+        return td_static(i);
+
+    const pii *first = td_pool.data() + td_start[k - 1], *last = td_pool.data() + td_start[k];
+    int tau = (t % TD_PERIOD + TD_PERIOD) % TD_PERIOD;
+    const pii *hi = upper_bound(first, last, pii(tau, INT_MAX));
+
+    // ҵtauĶϵ,Խһβʱƻȥ
+    pii a = hi == first ? pii(last[-1].first - TD_PERIOD, last[-1].second) : hi[-1];
+    pii b = hi == last ? pii(first->first + TD_PERIOD, first->second) : *hi;
+    if (b.first == a.first)
+        return a.second;
+    return a.second + (long long)(b.second - a.second) * (tau - a.first) / (b.first - a.first);
+}
+
+/*****************ʱdijkstra*************************
+ * ʱ̼㵽յ絽ʱ
+ *  ,յ,ʱ,Ƿʹʱ(falseʱȫtd_static())
+ *  td_arriveΪվ絽ʱ,·дpre
+ * ֵ յʱ,޷ʱΪ0x3f3f3f3f
+ * ˵߶Ƚȳ(絽),Ȼ԰ʱ̰;
+ *           յѼ,ֻñηʹվ
+ ************************************************************/
+int td_dijkstra(int st, int ed, int depart, bool use_profile)
+{
+    static vector<int> touched;
+    static vector<char> done;
+    if ((int)td_arrive.size() != N)
+        td_arrive.assign(N, 0x3f3f3f3f), done.assign(N, 0);
+    for (int u : touched)
+        td_arrive[u] = 0x3f3f3f3f, done[u] = 0;
+    touched.clear();
+
+    td_arrive[st] = depart;
+    touched.push_back(st);
+    priority_queue<pii, vector<pii>, greater<pii>> que;
+    que.push({depart, st});
+    while (!que.empty())
+    {
+        if (query_tick())
+            break;
+        int u = que.top().second;
+        que.pop();
+        if (done[u])
+            continue;
+        done[u] = true;
+        if (u == ed)
+            break;
+        int now = td_arrive[u];
+        for (int i = h[u]; ~i; i = ne[i])
+        {
+            int j = e[i];
+            if (j == -1)
+                continue;
+            int arrive = now + (use_profile ? td_travel(i, now) : td_static(i));
+            if (td_arrive[j] > arrive)
+            {
+                if (td_arrive[j] == 0x3f3f3f3f)
+                    touched.push_back(j);
+                td_arrive[j] = arrive;
+                pre[j] = u;
+                que.push({arrive, j});
+            }
+        }
+    }
+    return td_arrive[ed];
+}
+
+/***********************************************
+ * Ӱʱ,ͬһӳӰ˵Ⱥ
+ *  
+ *  źcsa_conn
+ * ֵ void
+ * ˵operator<ֻȽʱ,0ӵͬһǰʱ(ǰһĵվ
+ *           Ǻһĳվ)ͬ,˳ȷ,ɨʱ©;һ
+ *           ϵ,ÿȡһʣӵ;
+ *           ͬһƻԭվγɻʱ޷ų,ԭ˳ȡ,ɨʱһظɨ
+ ************************************************************/
+void csa_sort()
+{
+    stable_sort(csa_conn.begin(), csa_conn.end());
+    for (size_t l = 0, r; l < csa_conn.size(); l = r)
+    {
+        int t = csa_conn[l].dep_time;
+        for (r = l + 1; r < csa_conn.size() && csa_conn[r].dep_time == t && csa_conn[r].arr_time == t; r++)
+            ;
+        if (csa_conn[l].arr_time != t || r - l < 2)
+            continue;
+
+        vector<Connection> rest(csa_conn.begin() + l, csa_conn.begin() + r);
+        for (size_t k = l; k < r; k++)
+        {
+            size_t pick = 0;
+            for (size_t a = 0; a < rest.size(); a++)
+            {
+                bool free = true;
+                for (size_t b = 0; b < rest.size() && free; b++)
+                    free = b == a || rest[b].arr_stop != rest[a].dep_stop;
+                if (free)
+                {
+                    pick = a;
+                    break;
+                }
+            }
+            csa_conn[k] = rest[pick];
+            rest.erase(rest.begin() + pick);
+        }
+    }
+}
+
+/*****************ɨ絽**********************
+ * ʹɨ㷨(CSA)ĳʱ̳վ絽ʱ
+ *  ,յ,ʱ
+ *  csa_arrΪվ絽ʱ,csa_inΪõ
+ * ֵ յʱ,޷ʱΪ0x3f3f3f3f
+ * ˵Ӱʱ,ֻӳʱ̿ʼ˳ɨһ,
+ *           ʱѾյ絽ʱʱǰ;
+ *           ͬһڵһ0ӿβӳɻ,csa_sort޷ų˳,
+ *           һظɨֱٱ仯
+ ************************************************************/
+int csa_earliest(int st, int ed, int depart)
+{
+    csa_arr.assign(N, 0x3f3f3f3f);
+    csa_in.assign(N, -1);
+    csa_trip_in.assign(csa_trips, -1);
+    csa_arr[st] = depart;
+
+    // ɨһ,Ƿ˳߸˵ʱ;
+    // ظɨʱ,ֻ֮ǰ()ϵĳ
+    auto scan = [&](size_t k)
+    {
+        const Connection &c = csa_conn[k];
+        bool on = csa_trip_in[c.trip] != -1 && csa_trip_in[c.trip] <= (int)k;
+        // Ѿ˳,ڷǰϵվ
+        if (!on && csa_arr[c.dep_stop] > c.dep_time)
+            return false;
+        bool changed = !on;
+        if (changed)
+            csa_trip_in[c.trip] = k;
+        if (c.arr_time < csa_arr[c.arr_stop])
+        {
+            csa_arr[c.arr_stop] = c.arr_time;
+            csa_in[c.arr_stop] = k;
+            changed = true;
+        }
+        return changed;
+    };
+
+    size_t first = lower_bound(csa_conn.begin(), csa_conn.end(), Connection{0, 0, depart, 0, 0}) - csa_conn.begin();
+    for (size_t k = first, r; k < csa_conn.size(); k = r)
+    {
+        if (query_tick())
+            break;
+        const Connection &c = csa_conn[k];
+        if (c.dep_time >= csa_arr[ed])
+            break;
+        for (r = k + 1; c.arr_time == c.dep_time && r < csa_conn.size() && csa_conn[r].dep_time == c.dep_time &&
+                        csa_conn[r].arr_time == c.dep_time;
+             r++)
+            ;
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (size_t q = k; q < r; q++)
+                changed = scan(q) || changed;
+            changed = changed && r - k > 1;
+        }
+    }
+    return csa_arr[ed];
+}
+
+/*****************ɨ**********************
+ * ʱ䴰ڴյв֧(ʱ,ʱ)
+ *  ,յ,ʱ䴰Ŀʼͽ
+ *  plansΪʱ̴絽еķ
+ * ֵ ɨ豻ֹʱʱΪϴĳʱ,Ϊ-1
+ * ˵ʱ̴ɨһ,ÿվάһ
+ *           Խ絽ҲԽķ;ֲķŻᱣ;
+ *           ʱֻгʱڴϴķ׼ȷ,plansֻЩ;
+ *           ͬһڵһ0csa_earliestһظɨֱٱ仯
+ ************************************************************/
+int csa_profile(int st, int ed, int from, int to, vector<pii> &plans)
+{
+    vector<vector<pii>> prof(N);                        // ÿվ(ʱ,յʱ),ʱ̵ݼ
+    vector<int> trip_best(csa_trips, 0x3f3f3f3f);       // ˳ܵյʱ
+    auto evaluate = [&](int stop, int t)
+    {
+        // ҳʱ̲tķ(,Ҳ)Ǹ
+        const vector<pii> &p = prof[stop];
+        int lo = 0, hi = p.size();
+        while (lo < hi)
+        {
+            int mid = (lo + hi) / 2;
+            if (p[mid].first >= t)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo == 0 ? 0x3f3f3f3f : p[lo - 1].second;
+    };
+
+    // ɨһ,Ƿ˳վķ
+    auto scan = [&](size_t k)
+    {
+        const Connection &c = csa_conn[k];
+        int best = c.arr_stop == ed ? c.arr_time : 0x3f3f3f3f;
+        best = min(best, trip_best[c.trip]);
+        best = min(best, evaluate(c.arr_stop, c.arr_time));
+        if (best >= 0x3f3f3f3f)
+            return false;
+        bool changed = false;
+        trip_best[c.trip] = min(trip_best[c.trip], best);
+
+        vector<pii> &p = prof[c.dep_stop];
+        if (p.empty() || best < p.back().second)
+        {
+            if (!p.empty() && p.back().first == c.dep_time)
+                p.back().second = best;
+            else
+                p.push_back({c.dep_time, best});
+            changed = true;
+        }
+        return changed;
+    };
+
+    int cut = -1;
+    for (size_t k = csa_conn.size(), l; k > 0; k = l)
+    {
+        const Connection &c = csa_conn[k - 1];
+        if (c.dep_time < from)
+            break;
+        if (query_tick())
+        {
+            cut = c.dep_time;
+            break;
+        }
+        for (l = k - 1; c.arr_time == c.dep_time && l > 0 && csa_conn[l - 1].dep_time == c.dep_time &&
+                        csa_conn[l - 1].arr_time == c.dep_time;
+             l--)
+            ;
+        // ڳֻи,ÿɨǰָһ֮ǰtrip_best
+        vector<pii> saved;
+        for (size_t q = l; q < k && k - l > 1; q++)
+            saved.push_back({csa_conn[q].trip, trip_best[csa_conn[q].trip]});
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (auto &item : saved)
+                trip_best[item.first] = item.second;
+            for (size_t q = k; q-- > l;)
+                changed = scan(q) || changed;
+            changed = changed && k - l > 1;
+        }
+    }
+
+    plans.clear();
+    for (auto it = prof[st].rbegin(); it != prof[st].rend(); it++)
+        if (it->first >= from && it->first <= to && it->first > cut)
+            plans.push_back(*it);
+    return cut;
+}
+
+/***************ѯ·*******************
+ * ѯ·
+ *  
+ *  ݾ
+ * ֵ void
+ * ˵
+ ************************************************************/
+void query_min_dist(int operate)
+{
+    /**
+    ֮·С,ʹõDijkstra㷨
+    ʱ临ӶN*logN,10000000ݷΧ
+    **/
+    cout << "Ҫѯ·յ: ";
+    st_min_dist = read_station(), ed_min_dist = read_station();
+    if (station_missing({st_min_dist, ed_min_dist}))
+    {
+        if (operate == 3) // k,֮벻λ
+        {
+            int oper;
+            cin >> oper;
+        }
+        return;
+    }
+
+    if (!comp_connected(st_min_dist, ed_min_dist))
+        dist[ed_min_dist] = 0x3f3f3f3f; // ͬһͨ,
+    else if (apsp_query(st_min_dist, ed_min_dist, 0))
+        ;
+    else if (operate == 4 || !goal_query(st_min_dist, ed_min_dist, 0)) // ͳ·Ҫdijkstra
+        dijkstra_dist(st_min_dist);
+    if (query_expired()) // û,ܴĽ
+    {
+        if (operate == 3) // k,֮벻λ
+        {
+            int oper;
+            cin >> oper;
+        }
+        return;
+    }
+
+    if (dist[ed_min_dist] >= 0x3f3f3f3f / 2)
+    {
+        cout << endl
+             << "޷!" << endl
+             << endl;
+
+        ui_pause(1500);
+        return;
+    }
+    else if (operate != 3)
+        cout << endl
+             << "㵽յĵ̾Ϊ: " << dist[ed_min_dist] << endl
+             << endl;
+
+    memset(path, -1, sizeof path);
+    if (operate != 3)
+        cout << "·Ϊ: ";
+    int tmp1, tmp2 = ed_min_dist, cnt = 1; // յͬʱ·ֻһվ
+    path[1] = ed_min_dist;
+
+    for (int i = 0; !(tmp2 == st_min_dist); ++i)
+    {
+        if (i == 0)
+            tmp1 = ed_min_dist;
+        else
+        {
+            tmp2 = pre[tmp1];
+            path[++cnt] = tmp2;
+            tmp1 = tmp2;
+        }
+    }
+
+    if (operate != 3)
+    {
+        for (int i = cnt; i >= 2; i--)
+            cout << out_id(path[i]) << " -> ";
+        cout << out_id(path[1]) << endl;
+    }
+
+    if (operate == 3)
+    {
+        cout << "Ҫѯǰk·: ";
+        int oper;
+        cin >> oper;
+        if (oper == -1)
+            return;
+        else
+        {
+            if (!alt_ready(0) && !geo_ready()) // ûеر½ֱ߾½ʱ,÷dijkstraĽΪۺ
+                dijkstra_dist(ed_min_dist);
+
+            bool found = A_star(st_min_dist, ed_min_dist, oper);
+            if (!found && query_expired()) // ʱȡ,Ѿҵǰ·
+            {
+                cout << "ѯδ,ֻҵǰ " << A_star_dist.size() << " ·" << endl;
+                for (size_t i = 0; i < A_star_dist.size(); i++)
+                    cout << " " << i + 1 << " ·ĳΪ: " << A_star_dist[i] << endl;
+            }
+            else if (!found)
+                cout << "" << endl;
+            else
+            {
+                for (int i = 0; i < oper; i++)
+                {
+                    cout << " " << i + 1 << " ·ĳΪ: " << A_star_dist[i] << endl;
+                    // if(i>0) cout<<st_min_dist<<' ';
+                    for (auto u : A_star_path[i])
+                        cout << u << ' ';
+                    cout << endl;
+                }
+            }
+        }
+    }
+
+    ui_pause(1500);
+    return;
+}
+
+/****************ѯС*********************
+ * ѯС
+ *  
+ *  ݾ
+ * ֵ void
+ * ˵
+ ************************************************************/
+void query_min_cost(int operate)
+{
+    cout << "ҪѯСѵյ: ";
+    st_min_dist = read_station(), ed_min_dist = read_station();
+    if (station_missing({st_min_dist, ed_min_dist}))
+        return;
+
+    if (!comp_connected(st_min_dist, ed_min_dist))
+        dist[ed_min_dist] = 0x3f3f3f3f; // ͬһͨ,
+    else if (apsp_query(st_min_dist, ed_min_dist, 1))
+        ;
+    else if (operate == 4 || !goal_query(st_min_dist, ed_min_dist, 1)) // ͳ·Ҫdijkstra
+        dijkstra_cost(st_min_dist);
+    if (query_expired())
+        return;
+
+    if (dist[ed_min_dist] >= 0x3f3f3f3f / 2)
+    {
+        cout << endl
+             << "޷!" << endl
+             << endl;
+        ui_pause(1500);
+        return;
+    }
+    else
+        cout << endl
+             << "㵽յСΪ: " << dist[ed_min_dist] << endl
+             << endl;
+
+    memset(path, -1, sizeof path);
+    cout << "С·Ϊ: ";
+    int tmp1, tmp2 = ed_min_dist, cnt = 1; // յͬʱ·ֻһվ
+    path[1] = ed_min_dist;
+
+    for (int i = 0; !(tmp2 == st_min_dist); ++i)
+    {
+        if (i == 0)
+            tmp1 = ed_min_dist;
+        else
+        {
+            tmp2 = pre[tmp1];
+            path[++cnt] = tmp2;
+            tmp1 = tmp2;
+        }
+    }
+    for (int i = cnt; i >= 2; i--)
+        cout << out_id(path[i]) << " -> ";
+    cout << out_id(path[1]) << endl;
+
+    ui_pause(1500);
+    return;
+}
+
+/****************ѯ·С·*****************
+ * ѯ·С·
+ *  
+ *  ·
+ * ֵ void
+ * ˵
+ ************************************************************/
+void quert_count_dist_and_cost()
+{
+    query_min_dist(4);
+    if (!query_expired() && ed_min_dist >= 0 && st_min_dist >= 0)
+        cout << "·: " << cnt[ed_min_dist] << "" << endl;
+    query_min_cost(4); // ʱȻεյ,
+    if (query_expired() || ed_min_dist < 0 || st_min_dist < 0)
+        return;
+    cout << "ٻ·: " << cnt[ed_min_dist] << "" << endl;
+    ui_pause(1500);
+}
+
+/*************Сת*********************
+ * Сת
+ *  յ
+ *  תԼ·
+ * ֵ void
+ * ˵
+ ************************************************************/
+void get_min_change()
+{
+    // ʹù Bfs
+    memset(vis_bus, false, sizeof vis_bus);
+    queue<pii> que;
+    cout << "ѯյ: ";
+    min_change_st = read_station(), min_change_ed = read_station();
+    if (station_missing({min_change_st, min_change_ed}))
+        return;
+    que.push({0, min_change_st});
+
+    if (!comp_connected(min_change_st, min_change_ed))
+    {
+        cout << endl
+             << "޷!" << endl
+             << endl;
+        ui_pause(1500);
+        return;
+    }
+
+    while (!que.empty())
+    {
+        if (query_tick())
+            return;
+        pii now = que.front();
+        que.pop();
+        int step = now.first, stop = now.second;
+        vis_bus[stop] = true;
+
+        for (int i = h[stop]; ~i; i = ne[i])
+        {
+            int j = e[i];
+            if (j == -1)
+                continue;
+            if (!vis_bus[j])
+            {
+                que.push({step + 1, j});
+                pre[j] = stop;
+
+                if (j == min_change_ed)
+                {
+                    cout << "ҪСתΪ: " << step << endl;
+                    goto next;
+                }
+            }
+        }
+    }
+
+next:;
+    int tmp1, tmp2 = min_change_ed, cnt = 1; // յͬʱ·ֻһվ
+    path[1] = min_change_ed;
+
+    cout << "Сת·Ϊ: ";
+    for (int i = 0; !(tmp2 == min_change_st); ++i)
+    {
+        if (i == 0)
+            tmp1 = min_change_ed;
+        else
+        {
+            tmp2 = pre[tmp1];
+            path[++cnt] = tmp2;
+            tmp1 = tmp2;
+        }
+    }
+    for (int i = cnt; i >= 2; i--)
+        cout << out_id(path[i]) << "->";
+    cout << out_id(path[1]) << endl;
+
+    ui_pause(1500);
+    return;
+}
+
+/***************鼯޸Ĳ************************
+ * 鼯޸Ĳ
+ * ޸ĵ
+ *  
+ * ֵ  ޸ĵx
+ * ˵
+ ************************************************************/
+int find(int x)
+{
+    if (x != p[x])
+        p[x] = find(p[x]);
+    return p[x];
+}
+
+/****************ѯС***************
+ * ѯжٳվʻվ
+ * 
+ *  
+ * ֵ 
+ * ˵
+ ************************************************************/
+void query_last_number()
+{
+    int cnt = 0, u_cnt = 0;
+    Edge edge[N];
+    for (auto bus_ : bus_line)
+        p[bus_] = bus_;
+    for (auto bus_ : bus_line)
+    {
+        if (bus[bus_])
+        {
+            for (int i = h[bus_]; ~i; i = ne[i])
+            {
+                int j = e[i];
+                if (j == -1)
+                    continue;
+                edge[u_cnt] = {bus_, j, dis[i]};
+                edge[++u_cnt] = {j, bus_, dis[i]};
+                if (find(bus_) != find(j))
+                {
+                    p[find(bus_)] = find(j);
+                    cnt++;
+                }
+            }
+        }
+    }
+
+    if (query_expired())
+        return;
+
+    int count_number = 0;
+    map<int, vector<int>> count_bus_stop;
+    set<int> bus_vis;
+    for (auto bus_ : bus_line)
+    {
+        if (bus[bus_])
+        {
+            if (p[bus_] == bus_)
+                count_number++;
+            bus_vis.insert(p[bus_]), count_bus_stop[p[bus_]].push_back(bus_);
+        }
+    }
+    if (count_number == 1)
+    {
+        cout << "ùվܹһȦ " << endl;
+
+        int answer = 0;
+        for (auto bus_ : bus_line)
+            p[bus_] = bus_;
+        sort(edge, edge + u_cnt);
+
+        for (int i = 0; i < u_cnt; i++)
+        {
+            if (query_tick()) // Сû,ֵȨֵ
+                return;
+            int u = edge[i].u, v = edge[i].v, w = edge[i].w;
+            if (find(u) != find(v))
+            {
+                p[find(u)] = find(v);
+                answer += w;
+            }
+        }
+
+        cout << "һȦСȨֵΪ: " << answer << endl;
+    }
+    else
+    {
+        cout << "վ֮䲻ܻൽվ!" << endl
+             << endl
+             << endl;
+        cout << "һ " << count_number << " ͨĹվ,ֱ: " << endl;
+        count_number = 1;
+        for (auto bus_ : bus_vis)
+        {
+            cout << "--------------- " << count_number++ << " --------------- " << endl;
+            for (auto bus__ : count_bus_stop[bus_])
+                cout << out_id(bus__) << " վ ";
+            cout << endl
+                 << "-------------------------------------" << endl;
+        }
+    }
+
+    ui_pause(1200);
+    return;
+}
+
+/*****************ˢվǷ񻹴***********************
+ * ڽӱǷδɾı,ˢbusվ״̬
+ *  
+ *  bus
+ * ֵ void
+ * ˵
+ ************************************************************/
+void refresh_bus()
+{
+    for (auto bus_ : bus_line)
+    {
+        bool flag = false;
+        for (int i = h[bus_]; ~i; i = ne[i])
+        {
+            int j = e[i];
+            if (j != -1)
+            {
+                flag = true;
+                break;
+            }
+        }
+        if (!flag)
+            bus[bus_] = false;
+        else
+            bus[bus_] = true;
+    }
+}
+
+/*****************жվ֮Ƿ·*******************
+ * жվ֮Ƿлûɾ·
+ *  վ(ڲ)
+ *  
+ * ֵ true-  false-û
+ * ˵make_deleteд־֮ǰжɾܷɹ
+ ************************************************************/
+bool route_exists(int st, int ed)
+{
+    for (int i = h[st]; ~i; i = ne[i])
+        if (e[i] == ed)
+            return true;
+    return false;
+}
+
+/*****************жܷ·*************************
+ * жܷվ֮·
+ *  վ(ڲ)
+ *  
+ * ֵ true-  false-·Ѿ
+ * ˵apply_newmake_newж,д־޸طʱһܳɹ
+ ************************************************************/
+bool route_can_add(int st, int ed)
+{
+    for (int i = h[st]; ~i; i = ne[i])
+    {
+        int j = e[i];
+        if (j == st)
+            return false;
+    }
+    return true;
+}
+
+/*****************ɾվ֮·***********************
+ * ɾվ֮·
+ *  վ(ڲ)
+ *  
+ * ֵ true-ɾɹ  false-·߲
+ * ˵make_delete־طŶͨ޸ͼ
+ ************************************************************/
+bool apply_delete(int st, int ed)
+{
+    bool flag_all = false;
+    for (int i = h[st]; ~i; i = ne[i])
+    {
+        int j = e[i];
+        if (j == ed)
+        {
+            flag_all = true;
+            e[i] = -1;
+            graph_version++;
+        }
+    }
+
+    for (int i = h[ed]; ~i; i = ne[i])
+    {
+        int j = e[i];
+        if (j == st)
+            e[i] = -1, graph_version++;
+    }
+    if (flag_all)
+        comp_repair(st, ed);
+
+    refresh_bus();
+    return flag_all;
+}
+
+/*****************վ֮·***********************
+ * վ֮·
+ *  վ(ڲ),Ѻ;
+ *  
+ * ֵ true-ӳɹ  false-·Ѿ
+ * ˵make_new־طŶͨ޸ͼ
+ ************************************************************/
+bool apply_new(int st, int ed, int cost, int dist_)
+{
+    if (!route_can_add(st, ed))
+        return false;
+
+    // ӱ,δֵվ,䴢
+    add(st, ed, cost, dist_), add(ed, st, cost, dist_);
+    if (!bus[st])
+        bus[st] = true;
+    if (!bus[ed])
+        bus[ed] = true;
+
+    refresh_bus();
+    return true;
+}
+
+/*****************CRC32Уֵ***************************
+ * һݵCRC32Уֵ
+ *  ݵʼַͳ
+ *  
+ * ֵ Уֵ
+ * ˵ڼ־ͿǷд
+ ************************************************************/
+unsigned int crc32(const void *data, size_t len)
+{
+    static unsigned int table[256];
+    static bool ready = false;
+    if (!ready)
+    {
+        for (unsigned int i = 0; i < 256; i++)
+        {
+            unsigned int c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        ready = true;
+    }
+
+    const unsigned char *p = (const unsigned char *)data;
+    unsigned int crc = 0xffffffffu;
+    for (size_t i = 0; i < len; i++)
+        crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    return crc ^ 0xffffffffu;
+}
+
+/*****************ļд****************************
+ * ˢC⻺,Ҫϵͳļд
+ *  ļָ
+ *  
+ * ֵ true-ɹ  false-ʧ
+ * ˵ֻfflushʱݿܻϵͳ,ϵᶪʧ
+ ************************************************************/
+bool journal_sync(FILE *fp)
+{
+    return fflush(fp) == 0 && _commit(_fileno(fp)) == 0;
+}
+
+/*****************ղ־************************
+ * ѵǰ·дļ,Ȼ޸־;
+ *           ֻ·,ʱʻʱ,,Ʊʱ̱
+ *  
+ *  ļ
+ * ֵ true-ɹ  false-ļдʧ
+ * ˵дʱļٸ,дһҲƻɿ;
+ *           м¼Ѱһ־,־ǰҲظط;
+ *           ȷʵд̺Ÿ־,ϵ󲻻ֿ𻵶־ѿյ
+ ************************************************************/
+bool journal_checkpoint()
+{
+    vector<JournalSegment> segments;
+    for (int i = 0; i + 1 < idx; i += 2)
+        if (e[i] != -1)
+            segments.push_back({out_id(e[i + 1]), out_id(e[i]), w[i], dis[i]});
+
+    SnapshotHeader head = {SNAPSHOT_MAGIC, (unsigned int)n, (unsigned int)segments.size(), journal_seq,
+                           crc32(segments.data(), segments.size() * sizeof(JournalSegment))};
+
+    string tmp = string(SNAPSHOT_FILE) + ".tmp";
+    FILE *fp = fopen(tmp.c_str(), "wb");
+    if (!fp)
+        return false;
+    bool ok = fwrite(&head, sizeof head, 1, fp) == 1 &&
+              fwrite(segments.data(), sizeof(JournalSegment), segments.size(), fp) == segments.size() &&
+              journal_sync(fp);
+    ok = fclose(fp) == 0 && ok;
+    if (!ok)
+        return false;
+
+    error_code ec;
+    filesystem::rename(tmp, SNAPSHOT_FILE, ec);
+    if (ec)
+        return false;
+
+    if (journal_fp)
+        fclose(journal_fp);
+    journal_fp = fopen(JOURNAL_FILE, "wb");
+    journal_count = 0;
+    return journal_fp != nullptr;
+}
+
+/*****************׷һ޸־**************************
+ * ޸ͼ֮ǰ,޸׷д־ļ
+ *  ,վ(ⲿ),Ѻ;
+ *  ־ļ
+ * ֵ void
+ * ˵ÿ¼źCRC32У,дд;
+ *           ־ﵽJOURNAL_COMPACTԶղ־;
+ *           ־ļ򲻿дʧʱʾû,޸ᶪʧ;
+ *           ûп־ʱʲôҲ
+ ************************************************************/
+void journal_append(int op_, int a, int b, int c, int d)
+{
+    if (!journal_enabled)
+        return;
+    if (!journal_fp)
+    {
+        cout << ": ޸־ļ޷,޸Ĳᱻ,󽫶ʧ!" << endl;
+        return;
+    }
+    JournalRecord rec = {++journal_seq, op_, a, b, c, d, 0};
+    rec.crc = crc32(&rec, offsetof(JournalRecord, crc));
+    if (fwrite(&rec, sizeof rec, 1, journal_fp) != 1 || !journal_sync(journal_fp))
+        cout << ": ޸־дʧ,޸ܶʧ!" << endl;
+
+    if (++journal_count >= JOURNAL_COMPACT)
+        pending_checkpoint = true;
+}
+
+/*****************ӿպ־ָ·**********************
+ * ȡһεĿ,طſ֮޸־
+ *  
+ *  ؽõͼ
+ * ֵ true-ָɹ  false-ûпջûѡ
+ * ˵־ĩβУʧܵļ¼(дһ)ᱻض;
+ *           ָֻܻ·,Ҫû¼
+ ************************************************************/
+bool journal_recover()
+{
+    FILE *fp = fopen(SNAPSHOT_FILE, "rb");
+    if (!fp)
+        return false;
+
+    SnapshotHeader head;
+    vector<JournalSegment> segments;
+    bool ok = fread(&head, sizeof head, 1, fp) == 1 && head.magic == SNAPSHOT_MAGIC;
+    if (ok)
+    {
+        segments.resize(head.count);
+        ok = fread(segments.data(), sizeof(JournalSegment), head.count, fp) == head.count &&
+             crc32(segments.data(), segments.size() * sizeof(JournalSegment)) == head.crc;
+    }
+    fclose(fp);
+    if (!ok)
+    {
+        cout << "ļ,·(ini)" << endl
+             << endl;
+        return false;
+    }
+
+    int flag;
+    cout << "⵽ϴα·(" << head.count << " ·),Ƿָ(1Ϊָ,0Ϊ): ";
+    cin >> flag;
+    cout << endl;
+    if (!flag)
+        return false;
+
+    auto start = chrono::steady_clock::now();
+    n = head.n;
+    memset(h, -1, sizeof h);
+    comp_reset();
+    for (auto &seg : segments)
+        add_route(seg.a, seg.b, seg.c, seg.d);
+    journal_seq = head.last_seq;
+
+    // طſ֮־,Уʧܵļ¼ͣ
+    int replayed = 0;
+    long long valid = 0;
+    fp = fopen(JOURNAL_FILE, "rb");
+    if (fp)
+    {
+        JournalRecord rec;
+        while (fread(&rec, sizeof rec, 1, fp) == 1 && rec.crc == crc32(&rec, offsetof(JournalRecord, crc)))
+        {
+            valid += sizeof rec;
+            if (rec.seq <= head.last_seq) // Ѿڿ
+                continue;
+            if (rec.op == JOURNAL_NEW)
+                apply_new(in_id(rec.a, true), in_id(rec.b, true), rec.c, rec.d);
+            else if (rec.op == JOURNAL_DELETE)
+                apply_delete(in_id(rec.a), in_id(rec.b));
+            journal_seq = rec.seq;
+            replayed++;
+        }
+        fclose(fp);
+
+        error_code ec;
+        if ((long long)filesystem::file_size(JOURNAL_FILE, ec) > valid)
+            filesystem::resize_file(JOURNAL_FILE, valid, ec);
+    }
+
+    journal_fp = fopen(JOURNAL_FILE, "ab");
+    journal_count = replayed;
+    double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "ָɹI(^^)J!  " << segments.size() << " ·,ط " << replayed
+         << " ޸־,ʱ " << used << " ms" << endl;
+    cout << "ע: ָֻ·,ʱʻʱ(18),ʱ̱(20),(25)Ʊ(27)Ҫ¼" << endl;
+    return true;
+}
+
+/*****************յУֵ**************************
+ * 㵱ǰͼĿĳȨֵµУֵ
+ *  (0Ϊ,1Ϊ)
+ *  
+ * ֵ Уֵ
+ * ˵ǩм¼ֵ,ػͼ޸ĺݴжǷʹ
+ ************************************************************/
+unsigned int hub_graph_crc(int type)
+{
+    snap_build();
+    vector<int> all;
+    all.insert(all.end(), snap_station.begin(), snap_station.end());
+    all.insert(all.end(), snap_off.begin(), snap_off.end());
+    all.insert(all.end(), snap_to.begin(), snap_to.end());
+    all.insert(all.end(), snap_wt[type].begin(), snap_wt[type].end());
+    return crc32(all.data(), all.size() * sizeof(int));
+}
+
+/*****************ñǩ************************
+ * һαǩ,hub[type]ĸָ
+ *  ,ݵʼַͳ
+ *  hub[type]
+ * ֵ true-  false-
+ * ˵սӳļͨʹ
+ ************************************************************/
+bool hub_attach(int type, const char *base, size_t size)
+{
+    HubIndex &hx = hub[type];
+    const HubHeader *head = (const HubHeader *)base;
+    if (size < sizeof(HubHeader) || head->magic != HUB_MAGIC || head->type != type)
+        return false;
+    size_t body = (size_t)(head->n + 1) * 2 * sizeof(int) + (size_t)head->entries * sizeof(int) + head->bytes;
+    if (size != sizeof(HubHeader) + body || crc32(base + sizeof(HubHeader), body) != head->crc)
+        return false;
+
+    hx.head = head;
+    hx.entry_off = (const int *)(base + sizeof(HubHeader));
+    hx.byte_off = hx.entry_off + head->n + 1;
+    hx.dist = hx.byte_off + head->n + 1;
+    hx.bytes = (const unsigned char *)(hx.dist + head->entries);
+    hx.version = -1;
+    return true;
+}
+
+/*****************ͷűǩ******************************
+ * رӳļhub[type]
+ *  (0Ϊ,1Ϊ)
+ *  hub[type]
+ * ֵ void
+ * ˵
+ ************************************************************/
+void hub_release(int type)
+{
+    HubIndex &hx = hub[type];
+    if (hx.view)
+        UnmapViewOfFile(hx.view);
+    if (hx.mapping)
+        CloseHandle(hx.mapping);
+    if (hx.file != INVALID_HANDLE_VALUE)
+        CloseHandle(hx.file);
+    hx = HubIndex();
+}
+
+/*****************ǩ**************************
+ * ü֦رע(PLL)Ϊÿվ㽨ǩ,浽ļ
+ *  (0Ϊ,1Ϊ)
+ *  hub[type]Լļ
+ * ֵ true-ɹ  false-ļдʧ(Կڴʹ)
+ * ˵ӴСÿվΪŦdijkstra,бǩ
+ *           ܵõڵǰľͼ֦,վ(Ŧ,);
+ *           ǩŦ,ֺñ䳤,
+ ************************************************************/
+bool hub_build(int type)
+{
+    snap_build();
+    int V = snap_n;
+    vector<int> order(V), rank(V);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [](int a, int b)
+         { int da = snap_off[a + 1] - snap_off[a], db = snap_off[b + 1] - snap_off[b];
+           return da != db ? da > db : a < b; });
+    for (int r = 0; r < V; r++)
+        rank[order[r]] = r;
+
+    vector<vector<pii>> label(V); // (Ŧ,)
+    vector<int> root(V, 0x3f3f3f3f), d(V, 0x3f3f3f3f), touched;
+    for (int r = 0; r < V; r++)
+    {
+        int s = order[r];
+        for (auto &x : label[s])
+            root[x.first] = x.second;
+
+        priority_queue<pii, vector<pii>, greater<pii>> que;
+        d[s] = 0;
+        touched.push_back(s);
+        que.push({0, s});
+        while (!que.empty())
+        {
+            auto now = que.top();
+            que.pop();
+            int u = now.second;
+            if (now.first > d[u])
+                continue;
+
+            bool pruned = false;
+            for (auto &x : label[u])
+                if (root[x.first] + x.second <= now.first)
+                {
+                    pruned = true;
+                    break;
+                }
+            if (pruned)
+                continue;
+            label[u].push_back({r, now.first});
+
+            for (int k = snap_off[u]; k < snap_off[u + 1]; k++)
+            {
+                int j = snap_to[k], nd = now.first + snap_wt[type][k];
+                if (d[j] > nd)
+                {
+                    if (d[j] == 0x3f3f3f3f)
+                        touched.push_back(j);
+                    d[j] = nd;
+                    que.push({nd, j});
+                }
+            }
+        }
+
+        for (int u : touched)
+            d[u] = 0x3f3f3f3f;
+        touched.clear();
+        for (auto &x : label[s])
+            root[x.first] = 0x3f3f3f3f;
+    }
+
+    // 
+    vector<int> entry_off(V + 1, 0), byte_off(V + 1, 0), ldist;
+    vector<unsigned char> bytes;
+    for (int u = 0; u < V; u++)
+    {
+        int prev = 0;
+        for (auto &x : label[u])
+        {
+            unsigned int delta = x.first - prev;
+            prev = x.first;
+            while (delta >= 0x80)
+                bytes.push_back((delta & 0x7f) | 0x80), delta >>= 7;
+            bytes.push_back(delta);
+            ldist.push_back(x.second);
+        }
+        entry_off[u + 1] = ldist.size();
+        byte_off[u + 1] = bytes.size();
+    }
+
+    HubHeader head = {HUB_MAGIC, type, V, (int)ldist.size(), (int)bytes.size(), hub_graph_crc(type), 0};
+    vector<char> buffer(sizeof head);
+    auto put = [&](const void *data, size_t len)
+    {
+        buffer.insert(buffer.end(), (const char *)data, (const char *)data + len);
+    };
+    put(entry_off.data(), entry_off.size() * sizeof(int));
+    put(byte_off.data(), byte_off.size() * sizeof(int));
+    put(ldist.data(), ldist.size() * sizeof(int));
+    put(bytes.data(), bytes.size());
+    head.crc = crc32(buffer.data() + sizeof head, buffer.size() - sizeof head);
+    memcpy(buffer.data(), &head, sizeof head);
+
+    hub_release(type);
+    hub[type].buffer.swap(buffer);
+    hub_attach(type, hub[type].buffer.data(), hub[type].buffer.size());
+    hub[type].version = graph_version;
+
+    string tmp = string(HUB_FILE[type]) + ".tmp";
+    FILE *fp = fopen(tmp.c_str(), "wb");
+    if (!fp)
+        return false;
+    bool ok = fwrite(hub[type].buffer.data(), 1, hub[type].buffer.size(), fp) == hub[type].buffer.size();
+    ok = fclose(fp) == 0 && ok;
+    error_code ec;
+    if (ok)
+        filesystem::rename(tmp, HUB_FILE[type], ec);
+    return ok && !ec;
+}
+
+/*****************ӳǩļ**************************
+ * ѱǩļӳ䵽ڴ,Ҳ
+ *  (0Ϊ,1Ϊ)
+ *  hub[type]
+ * ֵ true-ɹ  false-ļڻ
+ * ˵ѯֱӶȡӳҳ,̿Թͬһ
+ ************************************************************/
+bool hub_map(int type)
+{
+    hub_release(type);
+    HubIndex &hx = hub[type];
+    hx.file = CreateFileA(HUB_FILE[type], GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hx.file == INVALID_HANDLE_VALUE)
+        return false;
+    DWORD high = 0;
+    size_t size = GetFileSize(hx.file, &high) | ((unsigned long long)high << 32);
+    if (size > 0)
+        hx.mapping = CreateFileMappingA(hx.file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (hx.mapping)
+        hx.view = MapViewOfFile(hx.mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!hx.view || !hub_attach(type, (const char *)hx.view, size))
+    {
+        hub_release(type);
+        return false;
+    }
+    return true;
+}
+
+/*****************ǩǷ**************************
+ * жhub[type]Ƿ뵱ǰͼһ
+ *  (0Ϊ,1Ϊ)
+ *  
+ * ֵ true-ʹ  false-ûͼѾ޸
+ * ˵ͼ޸ĺ¼յУֵ,м¼ıȽ
+ ************************************************************/
+bool hub_ready(int type)
+{
+    HubIndex &hx = hub[type];
+    if (!hx.head)
+        return false;
+    if (hx.version == graph_version)
+        return true;
+    if (hx.head->graph_crc != hub_graph_crc(type) || hx.head->n != snap_n)
+        return false;
+    hx.version = graph_version;
+    return true;
+}
+
+/*****************ǩѯ******************************
+ * ϲվıǩ,õվ֮̾С
+ *  վ(ڲ),(0Ϊ,1Ϊ)
+ *  
+ * ֵ ̾С,޷ʱΪ0x3f3f3f3f
+ * ˵ǩŦ,һ߽һ߹鲢,ͬŦȡСֵ
+ ************************************************************/
+int hub_query(int a, int b, int type)
+{
+    const HubIndex &hx = hub[type];
+    a = snap_id[a], b = snap_id[b];
+    if (a < 0 || b < 0)
+        return 0x3f3f3f3f;
+
+    const unsigned char *pa = hx.bytes + hx.byte_off[a], *pb = hx.bytes + hx.byte_off[b];
+    int ia = hx.entry_off[a], ea = hx.entry_off[a + 1];
+    int ib = hx.entry_off[b], eb = hx.entry_off[b + 1];
+    auto next = [](const unsigned char *&p, int prev)
+    {
+        unsigned int x = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            x |= (unsigned int)(*p & 0x7f) << shift;
+            if (!(*p++ & 0x80))
+                break;
+        }
+        return prev + (int)x;
+    };
+
+    int best = 0x3f3f3f3f;
+    if (ia == ea || ib == eb)
+        return best;
+    int ra = next(pa, 0), rb = next(pb, 0);
+    while (true)
+    {
+        if (ra == rb)
+        {
+            best = min(best, hx.dist[ia] + hx.dist[ib]);
+            if (++ia == ea || ++ib == eb)
+                break;
+            ra = next(pa, ra), rb = next(pb, rb);
+        }
+        else if (ra < rb)
+        {
+            if (++ia == ea)
+                break;
+            ra = next(pa, ra);
+        }
+        else
+        {
+            if (++ib == eb)
+                break;
+            rb = next(pb, rb);
+        }
+    }
+    return best;
+}
+
+/*****************վ֮ɾ***********************
+ * վ֮ɾ
+ *  յ
+ *  
+ * ֵ 0-ɹ   -ʧ
+ * ˵ȼվ·,ȷɾܳɹд־,޸ͼ
+ ************************************************************/
+void make_delete()
+{
+    /**
+    úΪͼĽڵɾ,ʱ临ӶΪN
+    **/
+    cout << "ϳվյ: ";
+    make_delete_st = read_station(), make_delete_ed = read_station();
+    if (station_missing({make_delete_st, make_delete_ed}))
+        return;
+
+    if (!route_exists(make_delete_st, make_delete_ed))
+    {
+        cout << endl
+             << "·߲(ini)!" << endl
+             << endl;
+        ui_pause(1000);
+        return;
+    }
+
+    journal_append(JOURNAL_DELETE, out_id(make_delete_st), out_id(make_delete_ed), 0, 0);
+    apply_delete(make_delete_st, make_delete_ed);
+    cout << endl
+         << "ɾɹI(^^)J!" << endl
+         << endl;
+    ui_pause(1000);
+    return;
+}
+
+/********************վ************************
+ * վ
+ *  յ
+ *  
+ * ֵ 0-ɹ   -ʧ
+ * ˵µվŻڲ;ȼվ·,
+ *           ȷܳɹд־,޸ͼ
+ ************************************************************/
+void make_new()
+{
+    /**
+    úΪͼĽڵ,ʱ临ӶΪN
+    **/
+    cout << "վ·߲뻨Ѻ;: ";
+    int cost, dist_;
+
+    make_new_st = read_station(true), make_new_ed = read_station(true);
+    cin >> cost >> dist_;
+    if (station_missing({make_new_st, make_new_ed}))
+        return;
+
+    if (!route_can_add(make_new_st, make_new_ed))
+    {
+        cout << "·Ѿ(ini)!" << endl;
+        ui_pause(1500);
+        return;
+    }
+
+    journal_append(JOURNAL_NEW, out_id(make_new_st), out_id(make_new_ed), cost, dist_);
+    apply_new(make_new_st, make_new_ed, cost, dist_);
+
+    cout << endl
+         << "ӳɹI(^^)J!" << endl
+         << endl;
+    ui_pause(1000);
+    return;
+}
+
+/****************ѯеĹվϢ************************
+ * ѯеĹվϢ
+ *  
+ *  վϸϢ
+ * ֵ 0-ɹ   -ʧ
+ * ˵
+ ************************************************************/
+void get_busline_all()
+{
+    cout << "Ŀǰдڵվ: " << endl;
+    for (auto bustop : bus_line)
+    {
+        if (bus[bustop])
+        {
+            cout << "----------ǰվ: " << out_id(bustop) << "վ-----------" << endl;
+            cout << "ڸվϸϢ: " << endl;
+            for (int i = h[bustop]; ~i; i = ne[i])
+            {
+                int j = e[i];
+                if (j != -1)
+                    cout << "վ " << out_id(j) << "վ ,վľ" << dis[i] << ",վ֮ĻΪ: " << w[i] << "Ԫ" << endl;
+            }
+        }
+    }
+    cout << endl;
+    ui_pause(1500);
+}
+
+/****************ѯվϸϢ**********************
+ * ѯվϸϢ
+ *  վ
+ *  վϸϢ
+ * ֵ 0-ɹ   -ʧ
+ * ˵
+ ************************************************************/
+void get_busline_single()
+{
+    int now_bus;
+    cout << "ѯվ: ";
+    now_bus = read_station();
+    if (now_bus < 0 || !bus[now_bus])
+        cout << endl
+             << "վ㲻ڻѱɾ(ini)" << endl;
+    else
+    {
+        cout << "----------ǰվ: " << out_id(now_bus) << "վ-----------" << endl;
+        if (dict_name[now_bus] || dict_code[now_bus])
+            cout << "վ: " << station_label(now_bus, 0) << "  : " << station_label(now_bus, 1) << endl;
+        cout << "ڸվϸϢ: " << endl;
+        for (int i = h[now_bus]; ~i; i = ne[i])
+        {
+            int j = e[i];
+            if (e[i] != -1)
+                cout << "վ " << out_id(e[i]) << "վ,վľ" << dis[i] << ",վ֮ĻΪ: " << w[i] << "Ԫ" << endl
+                     << endl;
+        }
+    }
+    ui_pause(1500);
+}
+
+/*************Աȴ벢еԴ·*******************
+ * Աȴdijkstra벢delta-steppingʱͼٱ
+ *  , (0Ϊ,1Ϊ), Ͱdelta
+ *  ͬ߳µʱ,ٱԼǷһ
+ * ֵ void
+ * ˵߳1,2,4...ֱCPU
+ ************************************************************/
+void query_parallel_sssp()
+{
+    int st, type, delta;
+    cout << ", (0Ϊ,1Ϊ)ԼͰdelta: ";
+    st = read_station();
+    cin >> type >> delta;
+    if (station_missing({st}))
+        return;
+
+    auto start = chrono::steady_clock::now();
+    if (type)
+        dijkstra_cost(st);
+    else
+        dijkstra_dist(st);
+    double serial = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    if (query_expired())
+        return;
+    vector<int> expect(dist, dist + N);
+
+    cout << endl
+         << "dijkstraʱ: " << serial << " ms" << endl;
+
+    int max_threads = max(1u, thread::hardware_concurrency());
+    vector<int> thread_list;
+    for (int t = 1; t < max_threads; t *= 2)
+        thread_list.push_back(t);
+    thread_list.push_back(max_threads);
+
+    for (int t : thread_list)
+    {
+        if (query_expired()) // Ѿ߳ճ
+            break;
+        start = chrono::steady_clock::now();
+        delta_stepping(st, type, delta, t);
+        double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (query_expired()) // û,
+            break;
+        bool same = equal(expect.begin(), expect.end(), dist);
+        cout << "߳ " << t << " : ʱ " << used << " ms, ٱ " << (used > 0 ? serial / used : 0)
+             << ", " << (same ? "봮һ" : "봮вһ!") << endl;
+    }
+
+    ui_pause(1500);
+}
+
+/***************رȫԴ·ģʽ*****************
+ * رȫԴ·ģʽ
+ *  1-  0-ر
+ *  ʱԼڴռ
+ * ֵ void
+ * ˵1,2ֱӲ,ͼ޸ĺڸ޸Ĳʱ¼
+ ************************************************************/
+void set_apsp_mode()
+{
+    int flag;
+    cout << "ǷȫԴ·ģʽ(1Ϊ,0Ϊر): ";
+    cin >> flag;
+
+    if (!flag)
+    {
+        apsp_enabled = false;
+        for (int type = 0; type < 2; type++)
+        {
+            vector<int>().swap(apsp_dist[type]);
+            vector<int>().swap(apsp_cnt[type]);
+            vector<unsigned short>().swap(apsp_pre[type]);
+        }
+        apsp_version = -1;
+        cout << endl
+             << "ѹرղģʽ" << endl;
+        ui_pause(1000);
+        return;
+    }
+
+    snap_build();
+    if (snap_n > APSP_MAX)
+    {
+        cout << endl
+             << "վΪ " << snap_n << ",˲ģʽ " << APSP_MAX << " վ(ini)" << endl;
+        ui_pause(1500);
+        return;
+    }
+
+    apsp_enabled = true;
+    auto start = chrono::steady_clock::now();
+    apsp_build();
+    double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    size_t bytes = (size_t)apsp_n * apsp_n * (2 * sizeof(int) + sizeof(unsigned short)) * 2;
+
+    cout << endl
+         << "ѿģʽ, " << apsp_n << " վ,ʱ " << used << " ms,ռڴ "
+         << bytes / 1024.0 / 1024.0 << " MB" << endl;
+    ui_pause(1500);
+}
+
+/***************ѯԤܵվ**********************
+ * ѯһվ,ڸ򻨷ܵվ
+ *  (0Ϊ,1Ϊ),Ԥ,Լ
+ *  ܵվԼӦľ򻨷
+ * ֵ void
+ * ˵
+ ************************************************************/
+void query_reachable()
+{
+    int type, budget, k;
+    cout << "(0Ϊ,1Ϊ)ԼԤ(׻Ԫ): ";
+    cin >> type >> budget;
+    cout << "ĸԼ: ";
+    cin >> k;
+    vector<int> sources(k);
+    for (int i = 0; i < k; i++)
+        sources[i] = read_station();
+    if (any_of(sources.begin(), sources.end(), [](int v)
+               { return v < 0; }))
+    {
+        station_missing({-1});
+        return;
+    }
+
+    vector<pii> reached;
+    bounded_search(sources, type, budget, reached);
+
+    cout << endl
+         << "Ԥ " << budget << (type ? " Ԫ" : " ") << " ܵվ㹲 " << reached.size() << " : " << endl;
+    for (auto &item : reached)
+        cout << out_id(item.first) << "վ : " << item.second << (type ? "Ԫ" : "") << endl;
+
+    ui_pause(1500);
+}
+
+/*****************վ±****************************
+ * վ±,±ǰľֲԶԱ
+ *  ŷʽ(1ΪBFS,2ΪRCM)
+ *  ߵƽſ,ģ⻺ȱʧԼdijkstraʱ
+ * ֵ void
+ * ˵Ȼʹԭվ,ֻʱת
+ ************************************************************/
+void make_reorder()
+{
+    int mode;
+    cout << "±ŵķʽ(1ΪBFS˳,2ΪRCM˳,3Ϊϣ˳): ";
+    cin >> mode;
+    if (mode < 1 || mode > 3)
+    {
+        cout << endl
+             << "ñŷʽ(ini)" << endl;
+        ui_pause(1000);
+        return;
+    }
+    if (mode == 3)
+    {
+        bool all = geo_cnt > 0;
+        for (int i = 0; i < N && all; i++)
+            if (h[i] != -1 && !geo_has[i])
+                all = false;
+        if (!all)
+        {
+            cout << endl
+                 << "ϣ˳Ҫվ㶼,¼" << endl;
+            ui_pause(1000);
+            return;
+        }
+    }
+
+    // ȡɸ̶ⲿվΪ,֤ǰͬһѯ
+    vector<int> samples;
+    for (size_t k = 0; k < bus_line.size() && samples.size() < 16; k += max<size_t>(1, bus_line.size() / 16))
+        samples.push_back(out_id(bus_line[k]));
+
+    auto measure = [&](double &span, long long &miss, double &used)
+    {
+        long long total = 0, edges = 0;
+        for (int i = 0; i < idx; i++)
+            if (e[i] != -1)
+                total += abs(e[i] - e[i ^ 1]), edges++;
+        span = edges ? (double)total / edges : 0;
+
+        miss = 0;
+        for (int x : samples)
+            miss += count_cache_miss(in_id(x));
+
+        auto start = chrono::steady_clock::now();
+        for (int x : samples)
+            dijkstra_dist(in_id(x));
+        used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    double span_before, span_after, used_before, used_after;
+    long long miss_before, miss_after;
+    measure(span_before, miss_before, used_before);
+    reorder_stations(mode);
+    measure(span_after, miss_after, used_after);
+
+    cout << endl
+         << "±, " << inner_cnt << " վ" << endl;
+    cout << "˱ŵƽ: " << span_before << " -> " << span_after << endl;
+    cout << samples.size() << " dijkstraģ⻺ȱʧ: " << miss_before << " -> " << miss_after << endl;
+    cout << samples.size() << " dijkstraʱ: " << used_before << " ms -> " << used_after << " ms" << endl;
+    ui_pause(1500);
+}
+
+/*****************ѹڽӱЧԱ**********************
+ * ѹͼ,ڽӱڴռԼѯٶȶԱ
+ *  
+ *  ڽӱڴռ,dijkstraʱԼǷһ
+ * ֵ void
+ * ˵ֻڲѹЧ,ѯȻʹԭڽӱͿ;
+ *           ѹͼձͬһͼ,ֻԱ,ԱȽͷѹͼ
+ ************************************************************/
+void query_compressed()
+{
+    auto start = chrono::steady_clock::now();
+    cg_build();
+    double build = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    // ڽӱвѯõĲ(snap_eidֻһԭ,)ѹͼϢͬ
+    size_t V = snap_n, E = cg_edge_off[snap_n];
+    size_t snapshot = (V + 1 + 3 * E) * sizeof(int); // snap_off,snap_to,snap_wt[2]
+    size_t packed = cg_bytes.capacity() + cg_wt[0].capacity() + cg_wt[1].capacity() +
+                    (cg_node_off.capacity() + cg_edge_off.capacity()) * sizeof(unsigned int);
+
+    cout << endl
+         << "ѹͼʱ " << build << " ms(ֻڱζԱ,ѯʹԭڽӱ)" << endl;
+    cout << "ڽӱ " << snapshot / 1024.0 << " KB,ѹͼ " << packed / 1024.0 << " KB,ǿյ "
+         << (snapshot ? 100.0 * packed / snapshot : 0) << "%" << endl;
+    cout << "ÿռ " << cg_width[0] << " ֽ,ÿռ " << cg_width[1] << " ֽ" << endl;
+
+    vector<int> samples;
+    for (int u = 0; u < snap_n && samples.size() < 16; u += max(1, snap_n / 16))
+        samples.push_back(snap_station[u]);
+
+    for (int type = 0; type < 2; type++)
+    {
+        double plain = 0, packed = 0;
+        bool same = true;
+        int done = 0;
+        for (int st : samples)
+        {
+            start = chrono::steady_clock::now();
+            if (type)
+                dijkstra_cost(st);
+            else
+                dijkstra_dist(st);
+            if (query_expired()) // εdijkstraû,Ա
+                break;
+            plain += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            vector<int> expect(dist, dist + N);
+
+            start = chrono::steady_clock::now();
+            dijkstra_compressed(st, type);
+            if (query_expired())
+                break;
+            packed += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            same = same && equal(expect.begin(), expect.end(), dist);
+            done++;
+        }
+        if (!done)
+            break;
+        cout << (type ? "С: " : "̾: ") << done << " βѯԭڽӱʱ " << plain
+             << " ms,ѹͼʱ " << packed << " ms,ʱΪ " << (plain > 0 ? packed / plain : 0) << ","
+             << (same ? "һ" : "һ!") << endl;
+    }
+
+    cg_version = -1;
+    vector<unsigned int>().swap(cg_node_off);
+    vector<unsigned int>().swap(cg_edge_off);
+    vector<unsigned char>().swap(cg_bytes);
+    vector<unsigned char>().swap(cg_wt[0]);
+    vector<unsigned char>().swap(cg_wt[1]);
+    ui_pause(1500);
+}
+
+/*****************ֶ******************************
+ * ·ղ޸־
+ *  
+ *  ļ
+ * ֵ void
+ * ˵ûп־ʱֻʾ
+ ************************************************************/
+void make_checkpoint()
+{
+    if (!journal_enabled)
+    {
+        cout << endl
+             << "ûпպ޸־, --journal " << endl;
+        ui_pause(1000);
+        return;
+    }
+    auto start = chrono::steady_clock::now();
+    bool ok = journal_checkpoint();
+    double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    if (ok)
+        cout << endl
+             << "ձɹI(^^)J! ʱ " << used << " ms(ֻ·,Ҫ¼)" << endl;
+    else
+        cout << endl
+             << "ձʧ(ini)," << endl;
+    ui_pause(1000);
+}
+
+/***************رALTر************************
+ * رALTر
+ *  1-  0-ر
+ *  ԤʱԼռõڴ
+ * ֵ void
+ * ˵1,2ʹALTA*ѯ,3Ҫdijkstra
+ ************************************************************/
+void set_alt_mode()
+{
+    int flag;
+    cout << "ǷALTر(1Ϊ,0Ϊر): ";
+    cin >> flag;
+
+    alt_enabled = flag;
+    if (!flag)
+    {
+        for (int type = 0; type < 2; type++)
+        {
+            vector<int>().swap(alt_d[type]);
+            alt_mark[type].clear();
+            alt_version[type] = -1;
+        }
+        cout << endl
+             << "ѹرALTر" << endl;
+        ui_pause(1000);
+        return;
+    }
+
+    auto start = chrono::steady_clock::now();
+    alt_ready(0), alt_ready(1);
+    double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    size_t bytes = (alt_d[0].size() + alt_d[1].size()) * sizeof(int);
+
+    cout << endl
+         << "ѿALTر, " << alt_mark[0].size() << " ر,Ԥʱ " << used << " ms,ռڴ "
+         << bytes / 1024.0 / 1024.0 << " MB" << endl;
+    cout << "ر: ";
+    for (int l : alt_mark[0])
+        cout << out_id(snap_station[l]) << ' ';
+    cout << endl
+         << "ѵر: ";
+    for (int l : alt_mark[1])
+        cout << out_id(snap_station[l]) << ' ';
+    cout << endl;
+    ui_pause(1500);
+}
+
+/***************·εʱʻʱ*******************
+ * Ϊվ֮·÷ʱεʻʱ
+ *  վ,ϵkԼk(ʱ,ʻʱ);
+ *            kΪ0ʾָ̬,kΪʾõ-kе
+ *  
+ * ֵ void
+ * ˵ʱΪһеķ(0~1439),ڶϵ֮ʻʱٵòܱʱŵÿ,
+ *           бʲС-1,֤絽(Ƚȳ)
+ ************************************************************/
+void set_td_profile()
+{
+    int a, b, k;
+    cout << "·εվԼϵ(0Ϊָ̬,Ϊ): ";
+    a = read_station(), b = read_station();
+    cin >> k;
+
+    int prof = 0;
+    if (k > 0)
+    {
+        cout << "ÿϵʱ()ʻʱ(): ";
+        vector<pii> points(k);
+        for (auto &pt : points)
+            cin >> pt.first >> pt.second;
+        sort(points.begin(), points.end());
+
+        bool ok = true;
+        for (int t = 0; t < k; t++)
+        {
+            pii x = points[t], y = t + 1 < k ? points[t + 1] : pii(points[0].first + TD_PERIOD, points[0].second);
+            if (x.first < 0 || x.first >= TD_PERIOD || x.second < 0 || (t + 1 < k && x.first == y.first) ||
+                y.second - x.second < -(y.first - x.first))
+                ok = false;
+        }
+        if (!ok)
+        {
+            cout << endl
+                 << "߲Ϸ(ini): ʱ0~1439֮һͬ,ʻʱǸ,Ҳܳ絽" << endl;
+            ui_pause(1500);
+            return;
+        }
+        td_pool.insert(td_pool.end(), points.begin(), points.end());
+        td_start.push_back(td_pool.size());
+        prof = td_start.size() - 1;
+    }
+    else if (k < 0)
+    {
+        prof = -k;
+        if (prof >= (int)td_start.size())
+        {
+            cout << endl
+                 << "߲(ini)" << endl;
+            ui_pause(1500);
+            return;
+        }
+    }
+
+    if (station_missing({a, b}))
+        return;
+    bool found = false;
+    for (int i = h[a]; ~i; i = ne[i])
+        if (e[i] == b)
+            td_prof[i] = td_prof[i ^ 1] = prof, found = true;
+
+    if (!found)
+        cout << endl
+             << "·߲(ini)!" << endl;
+    else if (prof)
+        cout << endl
+             << "óɹI(^^)J! ·ʹõ " << prof << " " << endl;
+    else
+        cout << endl
+             << "ѻָΪ̬ʻʱ" << endl;
+    ui_pause(1000);
+}
+
+/***************ʱ̲ѯ絽ʱ*******************
+ * ʱ̲ѯվ֮絽ʱ·
+ *  ,յ,ʱ()
+ *  絽ʱ,·Լÿվĵʱ
+ * ֵ void
+ * ˵ͬʱþ̬Ȩֵһ,ʱıֵ
+ ************************************************************/
+void query_td()
+{
+    int st, ed, depart;
+    cout << ",յԼʱ(,8:00Ϊ480): ";
+    st = read_station(), ed = read_station();
+    cin >> depart;
+    if (station_missing({st, ed}))
+        return;
+
+    if (depart < 0)
+    {
+        cout << endl
+             << "ʱ̲Ϊ(ini)" << endl;
+        ui_pause(1500);
+        return;
+    }
+    if (!comp_connected(st, ed))
+    {
+        cout << endl
+             << "޷!" << endl
+             << endl;
+        ui_pause(1500);
+        return;
+    }
+
+    auto start = chrono::steady_clock::now();
+    td_dijkstra(st, ed, depart, false);
+    double plain = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    int arrive = td_dijkstra(st, ed, depart, true);
+    double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    if (query_expired()) // û,ʱ̲һ
+        return;
+
+    auto clock_str = [](int t)
+    {
+        string day = t >= TD_PERIOD ? "(+" + to_string(t / TD_PERIOD) + ")" : "";
+        char buf[16];
+        snprintf(buf, sizeof buf, "%02d:%02d", t % TD_PERIOD / 60, t % 60);
+        return string(buf) + day;
+    };
+
+    cout << endl
+         << "絽ʱΪ: " << clock_str(arrive) << ",·Ϲʱ " << arrive - depart << " " << endl;
+    vector<int> route;
+    for (int u = ed; u != st; u = pre[u])
+        route.push_back(u);
+    route.push_back(st);
+    reverse(route.begin(), route.end());
+    cout << "·Ϊ: ";
+    for (size_t t = 0; t < route.size(); t++)
+        cout << out_id(route[t]) << "(" << clock_str(td_arrive[route[t]]) << ")" << (t + 1 < route.size() ? " -> " : "\n");
+    cout << "ʱѯʱ " << used << " ms,̬ѯʱ " << plain << " ms" << endl;
+    ui_pause(1500);
+}
+
+/*****************¼ʱ̱********************************
+ * ¼ʱ̱еİ
+ *  ,ÿ˳ͣվԼվ(վ,ʱ,ʱ)
+ *  ʱźcsa_conn
+ * ֵ void
+ * ˵վǱ,ƻ,·ͼеͬ,ʱΪ;
+ *           ¼ĳ׷ӵʱ̱;
+ *           վ㲻,ʱΪߵһվĳ˲¼,ʾû
+ ************************************************************/
+void load_timetable()
+{
+    int trips;
+    cout << "복ε: ";
+    cin >> trips;
+    cout << "ÿ˳ͣվ,Լվվ,ʱ̺ͳʱ(): " << endl;
+
+    int added = 0, rejected = 0;
+    for (int t = 0; t < trips; t++)
+    {
+        int k;
+        cin >> k;
+        vector<array<int, 3>> stops(max(k, 0)); // (վ,ʱ,ʱ)
+        bool ok = true;
+        for (auto &item : stops)
+        {
+            item[0] = read_station(true);
+            cin >> item[1] >> item[2];
+            if (item[0] < 0 || item[1] < 0 || item[2] < 0)
+                ok = false;
+        }
+        // һվʱ˳¼,˿ͻᱻһֱڳ϶ȱʧһ
+        for (int j = 1; j < k && ok; j++)
+            if (stops[j][1] < max(stops[j - 1][1], stops[j - 1][2]))
+                ok = false;
+        if (!ok)
+        {
+            cout << " " << t + 1 << " ˳վʱ,˳δ¼" << endl;
+            rejected++;
+            continue;
+        }
+
+        int last_stop = -1, last_dep = 0;
+        for (int j = 0; j < k; j++)
+        {
+            int stop = stops[j][0];
+            if (j > 0)
+            {
+                csa_conn.push_back({last_stop, stop, last_dep, stops[j][1], csa_trips});
+                added++;
+            }
+            last_stop = stop, last_dep = max(stops[j][1], stops[j][2]);
+        }
+        csa_trips++;
+    }
+    csa_sort();
+
+    cout << endl
+         << "¼ɹI(^^)J!  " << added << " ,ʱ̱й " << csa_trips << " ˳, "
+         << csa_conn.size() << " " << endl;
+    if (rejected)
+        cout << " " << rejected << " ˳Ϊδ¼" << endl;
+    ui_pause(1000);
+}
+
+/*****************ʱ̱ѯ******************************
+ * ʱ̱ѯ絽ʱ,ʱ䴰ֵѡĳʱ
+ *  ѯ(1Ϊ絽,2Ϊʱ䴰),,յ,ʱ̻ʱ䴰
+ *  絽ʱ̺ͳ˳,(,)
+ * ֵ void
+ * ˵
+ ************************************************************/
+void query_timetable()
+{
+    int type, st, ed;
+    cout << "ѯ(1Ϊ絽,2Ϊʱ䴰ڵĳ),յ: ";
+    cin >> type;
+    st = read_station(), ed = read_station();
+
+    auto clock_str = [](int t)
+    {
+        char buf[16];
+        snprintf(buf, sizeof buf, "%02d:%02d", t / 60, t % 60);
+        return string(buf);
+    };
+
+    if (type == 1)
+    {
+        int depart;
+        cout << "ʱ(): ";
+        cin >> depart;
+        if (station_missing({st, ed}))
+            return;
+        auto start = chrono::steady_clock::now();
+        int arrive = csa_earliest(st, ed, depart);
+        double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (query_expired())
+            return;
+        if (arrive >= 0x3f3f3f3f)
+        {
+            cout << endl
+                 << "޷!" << endl;
+            ui_pause(1500);
+            return;
+        }
+
+        vector<int> legs;
+        for (int u = ed; u != st; u = csa_conn[csa_in[u]].dep_stop)
+            legs.push_back(csa_in[u]);
+        reverse(legs.begin(), legs.end());
+
+        cout << endl
+             << "絽ʱΪ: " << clock_str(arrive) << ",ɨʱ " << used << " ms" << endl;
+        cout << "˳: " << endl;
+        for (size_t j = 0; j < legs.size();)
+        {
+            size_t r = j;
+            while (r + 1 < legs.size() && csa_conn[legs[r + 1]].trip == csa_conn[legs[j]].trip)
+                r++;
+            const Connection &a = csa_conn[legs[j]], &b = csa_conn[legs[r]];
+            cout << "   " << a.trip + 1 << " ˳: " << out_id(a.dep_stop) << "վ " << clock_str(a.dep_time)
+                 << " ϳ -> " << out_id(b.arr_stop) << "վ " << clock_str(b.arr_time) << " ³" << endl;
+            j = r + 1;
+        }
+    }
+    else
+    {
+        int from, to;
+        cout << "ʱ䴰Ŀʼͽʱ(): ";
+        cin >> from >> to;
+        if (station_missing({st, ed}))
+            return;
+        vector<pii> plans;
+        auto start = chrono::steady_clock::now();
+        int cut = csa_profile(st, ed, from, to, plans);
+        double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << endl
+             << "ʱ䴰ڹ " << plans.size() << " ֵѡĳʱ,ɨʱ " << used << " ms" << endl;
+        if (cut >= 0)
+            cout << "ɨδ,ֻг " << clock_str(cut) << " ֮ķ" << endl;
+        for (auto &plan : plans)
+            cout << "  " << clock_str(plan.first) << " , " << clock_str(plan.second) << " " << endl;
+    }
+    ui_pause(1500);
+}
+
+/*****************վĿɴԱ**********************
+ * ÿվһԶ·,ͳƿɴվƽ򻨷
+ *  (0Ϊ,1Ϊ)
+ *  Ԥʱ,ʱ,dijkstraĶԱԼƽֵСվ
+ * ֵ void
+ * ˵ȳdijkstra˶Խ,PHASTÿPHAST_LANES
+ ************************************************************/
+void query_accessibility()
+{
+    int type;
+    cout << "(0Ϊ,1Ϊ): ";
+    cin >> type;
+    type = type ? 1 : 0;
+
+    auto start = chrono::steady_clock::now();
+    if (ch_version[type] != graph_version)
+        ch_build(type);
+    double build = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    if (ch_version[type] != graph_version) // Ԥû
+    {
+        cout << endl
+             << "Ԥ " << build << " ms û,ûн,ò30ſطԤ" << endl;
+        return;
+    }
+    int V = snap_n;
+    cout << endl
+         << "Ԥʱ " << build << " ms,ݾ " << ch_shortcuts[type] << " " << endl;
+    if (V == 0)
+    {
+        ui_pause(1000);
+        return;
+    }
+
+    // ˶,ͬʱȫdijkstraҪʱ
+    vector<int> sample, d;
+    for (int v = 0; v < V && (int)sample.size() < PHAST_LANES; v += max(1, V / PHAST_LANES))
+        sample.push_back(v);
+    double plain = 0;
+    bool same = true;
+    phast_batch(sample, type, d);
+    for (size_t l = 0; l < sample.size(); l++)
+    {
+        auto t0 = chrono::steady_clock::now();
+        if (type)
+            dijkstra_cost(snap_station[sample[l]]);
+        else
+            dijkstra_dist(snap_station[sample[l]]);
+        if (query_expired())
+            return;
+        plain += chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        for (int v = 0; v < V; v++)
+            same = same && dist[snap_station[v]] == d[(size_t)ch_pos[type][v] * PHAST_LANES + l];
+    }
+
+    vector<long long> total(V, 0);
+    vector<int> reach(V, 0);
+    vector<int> batch;
+    int done = 0; // ʱǰ,ֻЩվ
+    start = chrono::steady_clock::now();
+    for (int s = 0; s < V && !query_expired(); s += PHAST_LANES)
+    {
+        batch.clear();
+        for (int l = 0; l < PHAST_LANES && s + l < V; l++)
+            batch.push_back(s + l);
+        phast_batch(batch, type, d);
+        for (int p = 0; p < V; p++)
+            for (size_t l = 0; l < batch.size(); l++)
+            {
+                int x = d[(size_t)p * PHAST_LANES + l];
+                if (x < 0x3f3f3f3f / 2)
+                    total[batch[l]] += x, reach[batch[l]]++;
+            }
+        done += batch.size();
+    }
+    double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "˶Խdijkstra" << (same ? "һ" : "һ!") << endl;
+    cout << "" << (done < V ? " " : "ȫ ") << done << " վһԶ·ʱ " << used
+         << " ms,ȫdijkstraԤҪ " << plain / sample.size() * V << " ms" << endl;
+
+    vector<int> order(done);
+    iota(order.begin(), order.end(), 0);
+    auto average = [&](int v)
+    {
+        return reach[v] > 1 ? (double)total[v] / (reach[v] - 1) : 1e18;
+    };
+    sort(order.begin(), order.end(), [&](int a, int b)
+         { return reach[a] != reach[b] ? reach[a] > reach[b] : average(a) < average(b); });
+    cout << "ɴվƽ" << (type ? "" : "") << "Сվ: " << endl;
+    for (int k = 0; k < done && k < 10; k++)
+        cout << "  " << out_id(snap_station[order[k]]) << "վ: ɴ " << reach[order[k]] - 1 << " վ,ƽ"
+             << (type ? " " : " ") << (reach[order[k]] > 1 ? average(order[k]) : 0) << endl;
+    ui_pause(1500);
+}
+
+/*****************ǩѯ**************************
+ * ǩ,ѯվ֮̾С
+ *  ,վ
+ *  ʱ,СԼѯ
+ * ֵ void
+ * ˵ֻͻ,·;뵱ǰͼһʱܲѯ
+ ************************************************************/
+void query_hub()
+{
+    int oper;
+    cout << "(1Ϊ,2Ϊļ,3Ϊѯ): ";
+    cin >> oper;
+
+    const char *name[2] = {"", ""};
+    if (oper == 1)
+    {
+        for (int type = 0; type < 2; type++)
+        {
+            auto start = chrono::steady_clock::now();
+            bool saved = hub_build(type);
+            double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            const HubHeader *head = hub[type].head;
+            size_t size = hub[type].buffer.size();
+            cout << name[type] << ": ʱ " << used << " ms, " << head->entries << " ǩ,ƽÿվ "
+                 << (head->n ? (double)head->entries / head->n : 0) << " ,ռ " << size / 1024.0 << " KB"
+                 << (saved ? "" : ",ļʧ") << endl;
+
+            // dijkstra˶
+            bool same = true;
+            vector<int> d;
+            for (int s = 0; s < snap_n; s += max(1, snap_n / 4))
+            {
+                snap_dijkstra(s, type, d);
+                for (int v = 0; v < snap_n; v++)
+                    same = same && min(d[v], 0x3f3f3f3f) == hub_query(snap_station[s], snap_station[v], type);
+            }
+            cout << "˶Խdijkstra" << (same ? "һ" : "һ!") << endl;
+        }
+    }
+    else if (oper == 2)
+    {
+        for (int type = 0; type < 2; type++)
+        {
+            if (!hub_map(type))
+                cout << name[type] << "ļڻ" << endl;
+            else if (!hub_ready(type))
+                cout << name[type] << "뵱ǰ·һ,½" << endl;
+            else
+                cout << name[type] << "ӳ䵽ڴ, " << hub[type].head->entries << " ǩ" << endl;
+        }
+    }
+    else if (oper == 3)
+    {
+        if (!hub_ready(0) || !hub_ready(1))
+        {
+            cout << "ڻ뵱ǰ·һ,Ƚ" << endl;
+            ui_pause(1000);
+            return;
+        }
+        int st, ed;
+        cout << "յ: ";
+        st = read_station(), ed = read_station();
+        if (station_missing({st, ed}))
+            return;
+
+        auto start = chrono::steady_clock::now();
+        int d0 = hub_query(st, ed, 0), d1 = hub_query(st, ed, 1);
+        double used = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+        if (d0 >= 0x3f3f3f3f / 2)
+            cout << endl
+                 << "޷!" << endl;
+        else
+            cout << endl
+                 << "̾Ϊ: " << d0 << ",СΪ: " << d1 << endl;
+        cout << "ѯʱ " << used << " us" << endl;
+    }
+    ui_pause(1500);
+}
+
+/*****************ѯѡ·******************************
+ * ѯվ֮伸Եıѡ·
+ *  ,յ,,·
+ *  ÿ·ߵĳȻ򻨷,·ߵıֵԼվ
+ * ֵ void
+ * ˵Ҫ,̶ΪROUTE_ROUNDS
+ ************************************************************/
+void query_alternatives()
+{
+    int st, ed, type, k;
+    cout << ",յ,(0Ϊ,1Ϊ)ԼҪ·: ";
+    st = read_station(), ed = read_station();
+    cin >> type >> k;
+    type = type ? 1 : 0;
+    if (station_missing({st, ed}))
+        return;
+
+    vector<vector<int>> routes;
+    vector<int> lengths;
+    auto start = chrono::steady_clock::now();
+    bool found = comp_connected(st, ed) && alternative_routes(st, ed, type, k, routes, lengths);
+    double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    if (!found && query_expired()) // ʱǰһ·Ҳûҵ,˵޷
+        return;
+    if (!found)
+    {
+        cout << endl
+             << "޷!" << endl
+             << endl;
+        ui_pause(1500);
+        return;
+    }
+
+    cout << endl
+         << "ҵ " << routes.size() << " ·,ʱ " << used << " ms" << endl;
+    for (size_t r = 0; r < routes.size(); r++)
+    {
+        cout << " " << r + 1 << " ·ߵ" << (type ? "" : "") << "Ϊ: " << lengths[r];
+        if (r > 0 && lengths[0] > 0)
+            cout << " (·ߵ " << (double)lengths[r] / lengths[0] << " )";
+        cout << endl;
+        for (size_t q = 0; q + 1 < routes[r].size(); q++)
+            cout << out_id(routes[r][q]) << " -> ";
+        cout << out_id(routes[r].back()) << endl;
+    }
+    if ((int)routes.size() < k)
+        cout << "Ե·ֻЩ" << endl;
+    ui_pause(1500);
+}
+
+/*****************¼վ******************************
+ * ¼ɸվγȺ;
+ *  վԼÿվ(,ƻ),γ,
+ *  geo_ͷȫֱ
+ * ֵ void
+ * ˵Զ¼,¼ĸ֮ǰ;վ㶼,
+ *           ѯ̾ʱԶʹֱ߾½
+ ************************************************************/
+void load_coordinates()
+{
+    int m_, skipped = 0;
+    cout << "Ҫ¼վ: ";
+    cin >> m_;
+    cout << "վ(,ƻ),γ,: " << endl;
+    for (int k = 0; k < m_; k++)
+    {
+        double lat, lon;
+        int v = read_station();
+        cin >> lat >> lon;
+        if (v < 0 || h[v] == -1 || fabs(lat) > 90 || fabs(lon) > 180)
+        {
+            skipped++;
+            continue;
+        }
+        geo_lat[v] = lat, geo_lon[v] = lon, geo_has[v] = true;
+    }
+    geo_project();
+
+    int missing = 0;
+    for (int i = 0; i < N; i++)
+        if (h[i] != -1 && !geo_has[i])
+            missing++;
+    cout << endl
+         << "¼ " << m_ - skipped << " վ";
+    if (skipped)
+        cout << ", " << skipped << " ڵվЧ";
+    cout << endl;
+    if (missing)
+        cout << " " << missing << " վû,ݲʹֱ߾½" << endl;
+    else if (geo_ready())
+        cout << "վ㶼,ѯ̾ʱʹֱ߾½" << endl;
+    else
+        cout << "·ξֱ߾ıֵΪ0,ʹֱ߾½" << endl;
+    ui_pause(1500);
+}
+
+/*****************ѯվ****************************
+ * ѯĳλkվ,뾶ڵվ
+ *  ѯ,γ,,k뾶()
+ *  վԼֱ߾
+ * ֵ void
+ * ˵ڰѳ˿͵Ķλվ
+ ************************************************************/
+void query_nearby()
+{
+    int type;
+    double lat, lon, arg;
+    cout << "ѯ(1Ϊkվ,2Ϊ뾶ڵվ),γ,Լk뾶(): ";
+    cin >> type >> lat >> lon >> arg;
+    if (!geo_cnt)
+    {
+        cout << endl
+             << "û¼վ" << endl;
+        ui_pause(1000);
+        return;
+    }
+
+    const double R = 6371000, RAD = acos(-1.0) / 180;
+    double x = R * lon * RAD * cos(geo_lat0), y = R * lat * RAD;
+    vector<pair<double, int>> res;
+    auto start = chrono::steady_clock::now();
+    if (type == 1)
+        geo_nearest(x, y, (int)arg, res);
+    else
+        geo_radius(x, y, arg, res);
+    double used = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+    cout << endl
+         << "ҵ " << res.size() << " վ,ʱ " << used << " us" << endl;
+    for (auto &item : res)
+        cout << out_id(item.second) << " վ: ֱ߾ " << (int)(item.first + 0.5) << " " << endl;
+    ui_pause(1500);
+}
+
+/*****************¼վƺͱ************************
+ * ¼ɸվƺͱ,½ϣ
+ *  վԼÿվ(Żе,),µ,(ûбʱ-)
+ *  dict_ͷȫֱ
+ * ֵ void
+ * ˵Զ¼,¼ĸǸվ֮ǰƺͱ;ƺͱ벻
+ *           ȫ,Ҳվظ,;֮ѯʱֱƻ
+ ************************************************************/
+void load_station_names()
+{
+    vector<pair<string, string>> label(N);
+    for (int i = 0; i < N; i++)
+        label[i] = {station_label(i, 0), station_label(i, 1)};
+
+    int m_, skipped = 0;
+    cout << "Ҫ¼Ƶվ: ";
+    cin >> m_;
+    cout << "վ(,ƻ),µ,(ûбʱ-): " << endl;
+    for (int k = 0; k < m_; k++)
+    {
+        string name, code;
+        int v = read_station();
+        cin >> name >> code;
+        if (v < 0 || h[v] == -1)
+        {
+            skipped++;
+            continue;
+        }
+        label[v] = {name, code == "-" ? "" : code};
+    }
+
+    // ַ,ظĻȫֵƺ
+    dict_arena.clear(), dict_keys.clear();
+    map<string, int> owner;
+    int rejected = 0;
+    auto intern = [&](const string &key, int v)
+    {
+        if (key.empty())
+            return 0;
+        if (key.find_first_not_of("-0123456789") == string::npos || owner.count(key))
+        {
+            rejected++;
+            return 0;
+        }
+        owner[key] = v;
+        dict_keys.push_back({(int)dict_arena.size(), (int)key.size(), v});
+        dict_arena += key;
+        return (int)dict_keys.size();
+    };
+    for (int i = 0; i < N; i++)
+        dict_name[i] = intern(label[i].first, i), dict_code[i] = intern(label[i].second, i);
+
+    auto start = chrono::steady_clock::now();
+    dict_build();
+    double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << endl
+         << " " << dict_keys.size() << " ƺͱ,ַ " << dict_arena.size() << " ֽ,ϣʱ "
+         << used << " ms" << endl;
+    if (skipped)
+        cout << " " << skipped << " ڵվ" << endl;
+    if (rejected)
+        cout << " " << rejected << " ظȫֵƺͱ" << endl;
+    ui_pause(1500);
+}
+
+/*****************ѯ****************************
+ * ·վ·,滮
+ *  ,(0Ϊȷ),ĸ
+ *  վ·Լʱ
+ * ֵ void
+ * ˵վܶʱֻһ,õֵ
+ ************************************************************/
+void query_betweenness()
+{
+    int type, samples, k;
+    cout << "(0Ϊ,1Ϊ),(0Ϊȫվ)Լĸ: ";
+    cin >> type >> samples >> k;
+    type = type ? 1 : 0;
+
+    vector<double> station_bc, segment_bc;
+    auto start = chrono::steady_clock::now();
+    int done = betweenness(type, samples, station_bc, segment_bc);
+    double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << endl
+         << ",ʱ " << used << " ms" << (done < snap_n ? "( " + to_string(done) + " )" : "") << endl;
+
+    vector<int> order(station_bc.size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](int a, int b)
+         { return station_bc[a] > station_bc[b]; });
+    cout << "·վ: " << endl;
+    for (int q = 0; q < k && q < (int)order.size(); q++)
+        cout << "  " << out_id(snap_station[order[q]]) << "վ: " << station_bc[order[q]] << endl;
+
+    order.resize(segment_bc.size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](int a, int b)
+         { return segment_bc[a] > segment_bc[b]; });
+    cout << "··: " << endl;
+    for (int q = 0; q < k && q < (int)order.size() && segment_bc[order[q]] > 0; q++)
+    {
+        int i = order[q] * 2;
+        cout << "  " << out_id(e[i + 1]) << " - " << out_id(e[i]) << ": " << segment_bc[order[q]] << endl;
+    }
+    ui_pause(1500);
+}
+
+/*****************·Է****************************
+ * ҳйرպʹ·Ͽ·()վ()
+ *  
+ *  ÿź͸,Լرպֵվ
+ * ֵ void
+ * ˵һO(V+E)DFSɾ·ͳͨ;
+ *           ϿСֵվӴС,Ӱǰ
+ ************************************************************/
+void query_disruption()
+{
+    vector<array<int, 3>> bridges;
+    vector<pair<int, vector<int>>> cuts;
+    auto start = chrono::steady_clock::now();
+    find_cut_points(bridges, cuts);
+    double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    sort(bridges.begin(), bridges.end(), [](const array<int, 3> &a, const array<int, 3> &b)
+         { return a[1] > b[1]; });
+    sort(cuts.begin(), cuts.end(), [](const pair<int, vector<int>> &a, const pair<int, vector<int>> &b)
+         { return a.second[a.second.size() - 2] > b.second[b.second.size() - 2]; });
+
+    cout << endl
+         << ",ʱ " << used << " ms" << endl;
+    cout << "رպʹ·Ͽ·ι " << bridges.size() << " : " << endl;
+    for (auto &b : bridges)
+    {
+        int i = b[0] * 2;
+        cout << "  " << out_id(e[i + 1]) << " - " << out_id(e[i]) << ": ֳ " << b[1] << " վ " << b[2]
+             << " վ" << endl;
+    }
+    cout << "رպʹ·Ͽվ㹲 " << cuts.size() << " : " << endl;
+    for (auto &c : cuts)
+    {
+        cout << "  " << out_id(snap_station[c.first]) << "վ: ֳ " << c.second.size() << " ,վֱΪ";
+        for (int x : c.second)
+            cout << ' ' << x;
+        cout << endl;
+    }
+    ui_pause(1500);
+}
+
+/*****************òѯʱԤ************************
+ * õѯطʱԤ
+ *  ,0ʾ
+ *  query_budget
+ * ֵ void
+ * ˵޸ͼͽĲԤ
+ ************************************************************/
+void set_query_budget()
+{
+    cout << "ǰѯʱԤΪ " << query_budget[QUERY_POINT] << " ms,طΪ " << query_budget[QUERY_HEAVY]
+         << " ms(0ʾ)" << endl;
+    cout << "ѯطʱԤ(,0ʾ): ";
+    int point, heavy;
+    cin >> point >> heavy;
+    query_budget[QUERY_POINT] = max(0, point);
+    query_budget[QUERY_HEAVY] = max(0, heavy);
+    cout << endl
+         << "" << endl;
+    ui_pause(1000);
+}
+
+/***********************************************
+ * ŵõ
+ *  
+ *  
+ * ֵ QUERY_POINT,QUERY_HEAVYQUERY_EDIT
+ * ˵޸ͼ,,¼Լö޸,;
+ ************************************************************/
+int query_class(int op_)
+{
+    static const set<int> edit = {5, 6, 12, 14, 16, 17, 18, 20, 23, 25, 27, 30, 31};
+    static const set<int> heavy = {3, 10, 11, 13, 15, 22, 28, 29};
+    if (edit.count(op_))
+        return QUERY_EDIT;
+    return heavy.count(op_) ? QUERY_HEAVY : QUERY_POINT;
+}
+
+/*****************ִһ******************************
+ * ŵöӦĺ
+ *  op
+ *  
+ * ֵ void
+ * ˵31(ִ)ѭֱӵ,ܳ
+ ************************************************************/
+void run_operation()
+{
+    if (op == 1)
+        query_min_dist(1);
+
+    else if (op == 2)
+        query_min_cost(2);
+
+    else if (op == 3)
+        query_min_dist(3);
+
+    else if (op == 4)
+        quert_count_dist_and_cost();
+
+    else if (op == 5)
+        make_delete();
+
+    else if (op == 6)
+        make_new();
+
+    else if (op == 7)
+        get_busline_all();
+
+    else if (op == 8)
+        get_busline_single();
+
+    else if (op == 9)
+        get_min_change();
+
+    else if (op == 10)
+        query_last_number();
+
+    else if (op == 11)
+        query_parallel_sssp();
+
+    else if (op == 12)
+        set_apsp_mode();
+
+    else if (op == 13)
+        query_reachable();
+
+    else if (op == 14)
+        make_reorder();
+
+    else if (op == 15)
+        query_compressed();
+
+    else if (op == 16)
+        make_checkpoint();
+
+    else if (op == 17)
+        set_alt_mode();
+
+    else if (op == 18)
+        set_td_profile();
+
+    else if (op == 19)
+        query_td();
+
+    else if (op == 20)
+        load_timetable();
+
+    else if (op == 21)
+        query_timetable();
+
+    else if (op == 22)
+        query_accessibility();
+
+    else if (op == 23)
+        query_hub();
+
+    else if (op == 24)
+        query_alternatives();
+
+    else if (op == 25)
+        load_coordinates();
+
+    else if (op == 26)
+        query_nearby();
+
+    else if (op == 27)
+        load_station_names();
+
+    else if (op == 28)
+        query_betweenness();
+
+    else if (op == 29)
+        query_disruption();
+
+    else if (op == 30)
+        set_query_budget();
+
+    else
+        cout << "ùܲ(ini),ڸĽ,ҪĹovo!" << endl;
+}
+
+/*****************ʱԤִһ*******************
+ * ýֹʱ,ִв,ʱȡʱʾ
+ *  
+ *  ʱȡʾ
+ * ֵ 0-  1-ʱ  2-ȡ
+ * ˵ѭͨquery_tick()Эʽؼֹʱȡ,
+ *           ʱֻѾȷȷĲֽ;޸ֹʱ
+ ************************************************************/
+int run_with_budget(int op_)
+{
+    int cls = query_class(op_);
+    query_ctx.status = 0;
+    query_ctx.cancel = false;
+    query_ctx.limited = cls != QUERY_EDIT && query_budget[cls] > 0;
+    if (query_ctx.limited)
+        query_ctx.deadline = chrono::steady_clock::now() + chrono::milliseconds(query_budget[cls]);
+    query_running = cls != QUERY_EDIT;
+
+    op = op_;
+    run_operation();
+
+    query_running = false;
+    if (cls == QUERY_EDIT)
+        apsp_refresh(); // ޸Ĳûнֹʱ,²,ѯвټ
+    int status = query_ctx.status;
+    if (status == 1)
+        cout << endl
+             << "ʱ(Ԥ " << query_budget[cls] << " ms),ǰ,ֻѾõĽ" << endl;
+    else if (status == 2)
+        cout << endl
+             << "ȡ,ֻѾõĽ" << endl;
+    query_ctx.limited = false;
+    query_ctx.status = 0;
+    query_ctx.cancel = false;
+
+    if (pending_checkpoint)
+    {
+        journal_checkpoint();
+        pending_checkpoint = false;
+    }
+    return status;
+}
+
+/*****************ִ******************************
+ * ,ȼִ,ÿ״̬ʱ
+ *  ,֮ÿһ(ԼòҪȫ)
+ *  ÿ,ԼͳƵʱ
+ * ֵ void
+ * ˵޸Ϊֽ߰ԭ˳ִ;޸֮Ĳѯ,
+ *           ѯط֮ǰ,˵Ĳѯںʱķȴ;
+ *           ÿȻܸʱԤ;
+ *           ִ߳(ѯȫֵdist,pre,ܲ),
+ *           ȼִֻ˳,ִе󲻻ᱻռ
+ ************************************************************/
+void run_batch()
+{
+    int m;
+    cout << "ĸ,֮ÿһ(ԼòҪ): ";
+    cin >> m;
+    string line;
+    getline(cin, line); // ʣµĲ
+    vector<pair<int, string>> reqs; // (, )
+    while ((int)reqs.size() < m && getline(cin, line))
+    {
+        istringstream in(line);
+        int op_;
+        if (in >> op_)
+            reqs.push_back({op_, line});
+    }
+
+    vector<int> order(reqs.size());
+    iota(order.begin(), order.end(), 0);
+    for (size_t l = 0, r; l < reqs.size(); l = r + 1)
+    {
+        r = l;
+        while (r < reqs.size() && query_class(reqs[r].first) != QUERY_EDIT)
+            r++;
+        stable_sort(order.begin() + l, order.begin() + r, [&](int a, int b)
+                    { return query_class(reqs[a].first) < query_class(reqs[b].first); });
+    }
+
+    const char *class_name[3] = {"ѯ", "ط", "޸"};
+    const char *status_name[4] = {"", "ʱ", "ȡ", ""};
+    int count[3] = {0}, late[3] = {0};
+    double total[3] = {0}, longest[3] = {0};
+    vector<string> report;
+    streambuf *keep = cin.rdbuf();
+    batch_mode = true;
+    for (int q : order)
+    {
+        int op_ = reqs[q].first, cls = query_class(op_);
+        istringstream in(reqs[q].second);
+        in >> op_;
+        cin.rdbuf(in.rdbuf()); // òһжȡʣµ
+        cin.clear();
+
+        auto start = chrono::steady_clock::now();
+        int status = op_ >= 1 && op_ <= 30 ? run_with_budget(op_) : 3; // ڵĲԼǶ׵ִ
+        double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (!cin)
+            status = 3;
+        cin.rdbuf(keep);
+        cin.clear();
+
+        count[cls]++, total[cls] += used, longest[cls] = max(longest[cls], used);
+        if (status == 1 || status == 2)
+            late[cls]++;
+        ostringstream out;
+        out << "   " << q + 1 << " ( " << op_ << ", " << class_name[cls] << "): " << status_name[status]
+            << ", ʱ " << used << " ms";
+        report.push_back(out.str());
+    }
+    batch_mode = false;
+
+    cout << endl
+         << "ִ˳,Ľ: " << endl;
+    for (auto &item : report)
+        cout << item << endl;
+    for (int c = 0; c < 3; c++)
+        if (count[c])
+            cout << class_name[c] << ": " << count[c] << " ,ƽʱ " << total[c] / count[c] << " ms, "
+                 << longest[c] << " ms,ʱȡ " << late[c] << " " << endl;
+    ui_pause(1500);
+}
+
+/*****************¼һκ˶Խ**************************
+ * Լĳһһκ˶Խͳ
+ *  ,Ƿһ
+ *  check_tally
+ * ֵ void
+ * ˵һγֵ˳
+ ************************************************************/
+void check_expect(const char *item, bool ok)
+{
+    for (auto &t : check_tally)
+        if (t.first == item)
+        {
+            t.second.first++, t.second.second += !ok;
+            return;
+        }
+    check_tally.push_back({item, {1, !ok}});
+}
+
+/*****************һִֵ********************
+ * ѱ׼뻻ɸ,α׼ִfn
+ *  ,Ҫִеĺ
+ *  
+ * ֵ fnȫ
+ * ˵ִеķʽ,ͣ;
+ *           ں˶ҪcinȡĲ
+ ************************************************************/
+string check_io(const string &input, const function<void()> &fn)
+{
+    istringstream in(input);
+    ostringstream out;
+    streambuf *keep_in = cin.rdbuf(in.rdbuf()), *keep_out = cout.rdbuf(out.rdbuf());
+    bool keep_batch = batch_mode;
+    cin.clear();
+    batch_mode = true;
+    fn();
+    batch_mode = keep_batch;
+    cin.rdbuf(keep_in), cout.rdbuf(keep_out);
+    cin.clear();
+    return out.str();
+}
+
+/*****************ֵ·½ͼ**********************
+ * յǰͼ,check_segs½ͼ,dijkstra֮Ļ׼
+ *  
+ *  ڽӱ,,check_Scheck_d
+ * ֵ void
+ * ˵޸ͼ(ɾ,±ŵ)ļʼʱ,õ뱾ֿʼʱͬͼ
+ ************************************************************/
+void check_load()
+{
+    memset(h, -1, sizeof h);
+    idx = 0;
+    for (int v : bus_line)
+        bus[v] = false;
+    bus_line.clear();
+    reordered = false, inner_cnt = 0;
+    comp_reset();
+    for (auto &seg : check_segs)
+        add_route(seg[0], seg[1], seg[2], seg[3]);
+    graph_version++;
+    snap_build();
+    check_S = snap_n;
+
+    for (int type = 0; type < 2; type++)
+    {
+        check_d[type].assign(check_S, vector<int>(check_S));
+        for (int s = 0; s < check_S; s++)
+        {
+            if (type)
+                dijkstra_cost(snap_station[s]);
+            else
+                dijkstra_dist(snap_station[s]);
+            for (int t = 0; t < check_S; t++)
+                check_d[type][s][t] = dist[snap_station[t]];
+        }
+    }
+}
+
+/*****************ɱֵͼ**************************
+ * һСͼ,ͼ׼
+ *  
+ *  check_segsԼcheck_load()ȫ
+ * ֵ true-ͼվ  false-ûκ·
+ * ˵վŷɢ0~3V֮,,ͼܲͨ;ûرߺԻ
+ ************************************************************/
+bool check_graph()
+{
+    int V = check_rng() % 40 + 2, M = check_rng() % (3 * V) + 1;
+    check_segs.clear();
+    set<pii> used;
+    for (int q = 0; q < M; q++)
+    {
+        int a = check_rng() % (3 * V), b = check_rng() % (3 * V);
+        if (a == b || !used.insert({min(a, b), max(a, b)}).second)
+            continue;
+        int c = check_rng() % 20 + 1, d = check_rng() % 100 + 1;
+        check_segs.push_back({a, b, c, d});
+    }
+    check_load();
+    return check_S > 0;
+}
+
+/*****************˶delta-stepping************************
+ * ѡ,Ͱ߳delta-stepping,׼˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵ͰС,ںʹڱȨ
+ ************************************************************/
+void check_delta_stepping()
+{
+    for (int q = 0; q < 4; q++)
+    {
+        int s = check_rng() % check_S, type = check_rng() % 2;
+        delta_stepping(snap_station[s], type, check_rng() % 30 + 1, check_rng() % 4 + 1);
+        for (int t = 0; t < check_S; t++)
+            check_expect("delta-stepping", dist[snap_station[t]] == check_d[type][s][t]);
+    }
+}
+
+/*****************˶ȫԴ·**************************
+ * ģʽ,Ѳõľ,··dijkstraĽ˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵ͼİ汾仯뷵false,apsp_refresh()֮ܲ;
+ *           ʱرղģʽ
+ ************************************************************/
+void check_apsp()
+{
+    auto path = [](int st, int ed)
+    {
+        vector<int> p = {ed};
+        while (p.back() != st && (int)p.size() <= check_S)
+            p.push_back(pre[p.back()]);
+        return p;
+    };
+
+    apsp_enabled = true;
+    apsp_build();
+    for (int type = 0; type < 2; type++)
+        for (int s = 0; s < check_S; s++)
+        {
+            int st = snap_station[s];
+            if (type)
+                dijkstra_cost(st);
+            else
+                dijkstra_dist(st);
+            vector<int> want_cnt(check_S);
+            vector<vector<int>> want_path(check_S);
+            for (int t = 0; t < check_S; t++)
+                if (check_d[type][s][t] < 0x3f3f3f3f)
+                    want_cnt[t] = cnt[snap_station[t]], want_path[t] = path(st, snap_station[t]);
+            for (int t = 0; t < check_S; t++)
+            {
+                int ed = snap_station[t];
+                bool ok = apsp_query(st, ed, type) && dist[ed] == check_d[type][s][t];
+                if (ok && check_d[type][s][t] < 0x3f3f3f3f)
+                    ok = cnt[ed] == want_cnt[t] && path(st, ed) == want_path[t];
+                check_expect("ȫԴ·", ok);
+            }
+        }
+
+    graph_version++; // ൱ͼ޸Ĺ
+    int st = snap_station[0];
+    check_expect("ȫԴ·", !apsp_query(st, st, 0));
+    apsp_refresh();
+    check_expect("ȫԴ·", apsp_query(st, st, 0) && dist[st] == 0);
+    apsp_enabled = false;
+}
+
+/*****************˶ԤڵĶ********************
+ * ѡɸԤbounded_search,׼иСֵ˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵ܵվ㼯Ϻÿվľ붼Ҫһ,Ұ˳벻
+ ************************************************************/
+void check_bounded_search()
+{
+    vector<pii> reached;
+    for (int q = 0; q < 4; q++)
+    {
+        int type = check_rng() % 2, budget = check_rng() % 200;
+        vector<int> sources, want(check_S, 0x3f3f3f3f);
+        for (int k = check_rng() % 3 + 1; k > 0; k--)
+        {
+            int s = check_rng() % check_S;
+            sources.push_back(snap_station[s]);
+            for (int t = 0; t < check_S; t++)
+                want[t] = min(want[t], check_d[type][s][t]);
+        }
+        bounded_search(sources, type, budget, reached);
+
+        map<int, int> got;
+        bool ok = true;
+        for (size_t i = 0; i < reached.size(); i++)
+        {
+            ok = ok && snap_id[reached[i].first] >= 0 && (i == 0 || reached[i - 1].second <= reached[i].second);
+            got[snap_id[reached[i].first]] = reached[i].second;
+        }
+        int reach = 0;
+        for (int t = 0; t < check_S; t++)
+            if (want[t] <= budget)
+                reach++, ok = ok && got.count(t) && got[t] == want[t];
+        check_expect("ԤڵĶ", ok && (int)got.size() == reach && got.size() == reached.size());
+    }
+}
+
+/*****************˶±******************************
+ * BFS,RCMϣַʽ±,˶Աת·
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵ԭⲿͨin_id()ѯ,ͻѱǰͬ;
+ *           ϣҪ,ȸÿվ,ʱ
+ ************************************************************/
+void check_reorder()
+{
+    for (int mode = 1; mode <= 3; mode++)
+    {
+        check_load();
+        vector<int> outer(snap_station); // û±,ڲžⲿ
+        if (mode == 3)
+        {
+            for (int v : outer)
+            {
+                geo_lat[v] = 30 + check_rng() % 10000 * 1e-5, geo_lon[v] = 120 + check_rng() % 10000 * 1e-5;
+                geo_has[v] = true;
+            }
+            geo_project();
+        }
+        reorder_stations(mode);
+
+        bool ok = true;
+        for (int v : outer)
+            ok = ok && out_id(in_id(v)) == v;
+        for (int type = 0; type < 2; type++)
+            for (int s = 0; s < check_S; s++)
+            {
+                if (type)
+                    dijkstra_cost(in_id(outer[s]));
+                else
+                    dijkstra_dist(in_id(outer[s]));
+                for (int t = 0; t < check_S; t++)
+                    ok = ok && dist[in_id(outer[t])] == check_d[type][s][t];
+            }
+        check_expect("±", ok);
+
+        if (mode == 3)
+        {
+            memset(geo_has, 0, sizeof geo_has);
+            geo_project();
+        }
+    }
+}
+
+/*****************˶ѹڽӱ****************************
+ * ѹͼϴÿվdijkstra,׼˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵ѹͼ,ھӱźȨֵֺͱ䳤
+ ************************************************************/
+void check_compressed()
+{
+    for (int type = 0; type < 2; type++)
+        for (int s = 0; s < check_S; s++)
+        {
+            dijkstra_compressed(snap_station[s], type);
+            for (int t = 0; t < check_S; t++)
+                check_expect("ѹڽӱ", dist[snap_station[t]] == check_d[type][s][t]);
+        }
+}
+
+/*****************˶ͨǩ**************************
+ * ˳ɾһ·,ÿɾһcomp_connectedBFSĽ˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵ͼʱɲ鼯ϲ,ɾߺcomp_repair,˶
+ ************************************************************/
+void check_components()
+{
+    check_load();
+    vector<int> stations(snap_station);
+    vector<array<int, 4>> segs = check_segs;
+    shuffle(segs.begin(), segs.end(), check_rng);
+    for (size_t q = 0; q <= segs.size() / 2; q++)
+    {
+        if (q)
+            apply_delete(segs[q - 1][0], segs[q - 1][1]);
+
+        map<int, int> label;
+        for (int r : stations)
+        {
+            if (label.count(r))
+                continue;
+            queue<int> que;
+            que.push(r), label[r] = r;
+            while (!que.empty())
+            {
+                int u = que.front();
+                que.pop();
+                for (int i = h[u]; ~i; i = ne[i])
+                    if (e[i] != -1 && !label.count(e[i]))
+                        label[e[i]] = r, que.push(e[i]);
+            }
+        }
+        bool ok = true;
+        for (int a : stations)
+            for (int b : stations)
+                ok = ok && comp_connected(a, b) == (label[a] == label[b]);
+        check_expect("ͨ", ok);
+    }
+}
+
+/*****************˶Կպ־Ļָ**********************
+ * պһϵ޸,ģдһ,ٴӿպ־ָ,˶·
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵޸вڵվ·(Ӧд־)Լ;±;
+ *           պ־дʱļ,ʱɾָԭļͿ
+ ************************************************************/
+void check_journal()
+{
+    auto segments = []()
+    {
+        vector<array<int, 4>> all;
+        for (int i = 0; i + 1 < idx; i += 2)
+            if (e[i] != -1)
+            {
+                int a = out_id(e[i + 1]), b = out_id(e[i]);
+                all.push_back({min(a, b), max(a, b), w[i], dis[i]});
+            }
+        sort(all.begin(), all.end());
+        return all;
+    };
+
+    check_load();
+    const char *keep[2] = {SNAPSHOT_FILE, JOURNAL_FILE};
+    SNAPSHOT_FILE = "bus_check_snapshot.bin", JOURNAL_FILE = "bus_check_journal.bin";
+    journal_enabled = true;
+    bool saved = journal_checkpoint();
+
+    int top = 0, reorder_at = check_rng() % 12; // վȡеŸ,Ҳվ
+    for (auto &seg : check_segs)
+        top = max(top, max(seg[0], seg[1]) + 4);
+    for (int q = 0; q < 12; q++)
+    {
+        ostringstream input;
+        int op_ = q == reorder_at ? 14 : check_rng() % 2 ? 5 : 6;
+        if (op_ == 14)
+            input << check_rng() % 2 + 1;
+        else
+        {
+            // żòڵƻ򳬳Χı
+            int kind = check_rng() % 8;
+            input << (kind == 0 ? "nowhere" : kind == 1 ? "-1" : to_string(check_rng() % top)) << ' '
+                  << check_rng() % top;
+            if (op_ == 6)
+                input << ' ' << check_rng() % 20 + 1 << ' ' << check_rng() % 100 + 1;
+        }
+        check_io(input.str(), [&]
+                 { run_with_budget(op_); });
+    }
+    vector<array<int, 4>> want = segments();
+
+    // ģ׷־ʱ: ĩβֻд˰¼
+    if (journal_fp)
+    {
+        fclose(journal_fp);
+        journal_fp = nullptr;
+        FILE *fp = fopen(JOURNAL_FILE, "ab");
+        if (fp)
+            fwrite("torn", 1, 4, fp), fclose(fp);
+    }
+
+    memset(h, -1, sizeof h);
+    idx = 0;
+    for (int v : bus_line)
+        bus[v] = false;
+    bus_line.clear();
+    reordered = false, inner_cnt = 0;
+    bool ok = false;
+    check_io("1", [&]
+             { ok = journal_recover(); });
+    error_code ec;
+    check_expect("պ־ָ", saved && ok && segments() == want &&
+                                       filesystem::file_size(JOURNAL_FILE, ec) % sizeof(JournalRecord) == 0);
+
+    if (journal_fp)
+        fclose(journal_fp);
+    journal_fp = nullptr;
+    remove(SNAPSHOT_FILE), remove(JOURNAL_FILE);
+    SNAPSHOT_FILE = keep[0], JOURNAL_FILE = keep[1];
+    journal_enabled = false, journal_count = 0, pending_checkpoint = false;
+}
+
+/*****************˶ALTر****************************
+ * ȨֵALT,ѵر½A*׼˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵ǰk·A*Ҳʹõر½Ϊۺ,ʹ÷dijkstraʱĽ˶;
+ *           ʱرALT,֮ļʹ
+ ************************************************************/
+void check_alt()
+{
+    alt_enabled = true;
+    for (int type = 0; type < 2; type++)
+    {
+        alt_build(type);
+        check_expect("ALT", alt_ready(type));
+        for (int s = 0; s < check_S; s++)
+            for (int t = 0; t < check_S; t++)
+            {
+                int ed = snap_station[t];
+                check_expect("ALT", goal_query(snap_station[s], ed, type) && dist[ed] == check_d[type][s][t]);
+            }
+    }
+
+    int a = snap_station[check_rng() % check_S], b = snap_station[check_rng() % check_S];
+    A_star(a, b, 20);
+    vector<int> with_alt = A_star_dist;
+    alt_enabled = false;
+    dijkstra_dist(b);
+    A_star(a, b, 20);
+    check_expect("ALT", A_star_dist == with_alt);
+}
+
+/*****************˶ʱdijkstra********************
+ * Լһ·ʱ,td_dijkstra밴巴ɳڵĽ˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵ͨset_td_profile¼,Ƚȳ߻ᱻܾ;
+ *           ɳбֱٱ仯,˳;ʱ
+ ************************************************************/
+void check_td()
+{
+    for (auto &seg : check_segs)
+    {
+        if (check_rng() % 2)
+            continue;
+        int k = check_rng() % 4 + 1, base = check_rng() % 60 + 1;
+        set<int> times;
+        while ((int)times.size() < k)
+            times.insert(check_rng() % TD_PERIOD);
+        ostringstream input;
+        input << seg[0] << ' ' << seg[1] << ' ' << k;
+        for (int t : times)
+            input << ' ' << t << ' ' << base + check_rng() % 20;
+        check_io(input.str(), set_td_profile);
+    }
+
+    auto brute = [](int st, int ed, int depart, bool use_profile)
+    {
+        vector<int> arrive(N, 0x3f3f3f3f);
+        arrive[st] = depart;
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (int i = 0; i < idx; i++)
+            {
+                int u = e[i ^ 1], j = e[i];
+                if (j == -1 || arrive[u] == 0x3f3f3f3f)
+                    continue;
+                int t = arrive[u] + (use_profile ? td_travel(i, arrive[u]) : td_static(i));
+                if (t < arrive[j])
+                    arrive[j] = t, changed = true;
+            }
+        }
+        return arrive[ed];
+    };
+    for (int q = 0; q < 20; q++)
+    {
+        int a = snap_station[check_rng() % check_S], b = snap_station[check_rng() % check_S];
+        int depart = check_rng() % (3 * TD_PERIOD);
+        for (int use_profile = 0; use_profile < 2; use_profile++)
+            check_expect("ʱdijkstra", td_dijkstra(a, b, depart, use_profile) == brute(a, b, depart, use_profile));
+    }
+
+    for (int i = 0; i < idx; i++)
+        td_prof[i] = 0;
+    td_pool.clear();
+    td_start = {0};
+}
+
+/*****************絽ʱ********************
+ * ӵ˳,ɳֱٱ仯
+ *  ,յ,ʱ
+ *  
+ * ֵ յʱ,޷ʱΪ0x3f3f3f3f
+ * ˵Լʱcsa_earliest˶;˲Ҫʱ,ڳ³ͬһ˳
+ *           ͬ,ֻжܷڷǰվ;ʱ临ӶO(^2)
+ ************************************************************/
+int csa_brute(int st, int ed, int depart)
+{
+    vector<int> arr(N, 0x3f3f3f3f);
+    arr[st] = depart;
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (auto &c : csa_conn)
+            if (arr[c.dep_stop] <= c.dep_time && c.arr_time < arr[c.arr_stop])
+                arr[c.arr_stop] = c.arr_time, changed = true;
+    }
+    return arr[ed];
+}
+
+/*****************˶ɨ******************************
+ * ʱ̱,ɨ絽ʱ䴰csa_brute˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵վ㼯ǰվ,0ӵӺͬһʱ̷;
+ *           ʱʱ̱
+ ************************************************************/
+void check_csa()
+{
+    csa_conn.clear();
+    csa_trips = check_rng() % 30 + 1;
+    int K = min(check_S, 8);
+    for (int trip = 0; trip < csa_trips; trip++)
+    {
+        int stops = check_rng() % 5 + 2, t = check_rng() % 100, at = check_rng() % K;
+        for (int j = 1; j < stops; j++)
+        {
+            int next = check_rng() % K, dep = t + check_rng() % 3, arr = dep + check_rng() % 10;
+            csa_conn.push_back({snap_station[at], snap_station[next], dep, arr, trip});
+            at = next, t = arr;
+        }
+    }
+    csa_sort();
+    for (int q = 0; q < 20; q++)
+    {
+        int a = snap_station[check_rng() % K], b = snap_station[check_rng() % K], depart = check_rng() % 120;
+        check_expect("ɨ", csa_earliest(a, b, depart) == csa_brute(a, b, depart));
+        if (a == b)
+            continue;
+
+        // ʱ䴰ÿ㷢ʱ̳һ,ȥȴķ
+        vector<pii> plans, want;
+        csa_profile(a, b, 0, 200, plans);
+        set<int> departs;
+        for (auto &c : csa_conn)
+            if (c.dep_stop == a && c.dep_time <= 200)
+                departs.insert(c.dep_time);
+        for (auto it = departs.rbegin(); it != departs.rend(); it++)
+        {
+            int arrive = csa_brute(a, b, *it);
+            if (arrive < 0x3f3f3f3f && (want.empty() || arrive < want.back().second))
+                want.push_back({*it, arrive});
+        }
+        reverse(want.begin(), want.end());
+        check_expect("ɨ", plans == want);
+    }
+    csa_conn.clear();
+    csa_trips = 0;
+}
+
+/*****************˶CH/PHAST******************************
+ * PHAST_LANESһPHAST,׼˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵ڵһʹʱ,ĺ
+ ************************************************************/
+void check_phast()
+{
+    vector<int> batch, res;
+    for (int type = 0; type < 2; type++)
+        for (int s = 0; s < check_S; s += PHAST_LANES)
+        {
+            batch.clear();
+            for (int l = s; l < check_S && l < s + PHAST_LANES; l++)
+                batch.push_back(l);
+            phast_batch(batch, type, res);
+            for (size_t l = 0; l < batch.size(); l++)
+                for (int t = 0; t < check_S; t++)
+                    check_expect("CH/PHAST", res[(size_t)ch_pos[type][t] * PHAST_LANES + l] == check_d[type][batch[l]][t]);
+        }
+}
+
+/*****************˶ǩ******************************
+ * ѸսıǩʹļӳĲѯ׼˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵дʱļ,е;ʱͷ,ɾʱļ
+ ************************************************************/
+void check_hub()
+{
+    const char *keep[2] = {HUB_FILE[0], HUB_FILE[1]};
+    HUB_FILE[0] = "bus_check_dist.bin", HUB_FILE[1] = "bus_check_cost.bin";
+    for (int type = 0; type < 2; type++)
+    {
+        for (int pass = 0; pass < 2; pass++)
+        {
+            if (pass == 0)
+                hub_build(type);
+            else if (!hub_map(type))
+            {
+                check_expect("ǩ", false);
+                continue;
+            }
+            for (int s = 0; s < check_S; s++)
+                for (int t = 0; t < check_S; t++)
+                    check_expect("ǩ", hub_query(snap_station[s], snap_station[t], type) == check_d[type][s][t]);
+        }
+        hub_release(type);
+        remove(HUB_FILE[type]);
+        HUB_FILE[type] = keep[type];
+    }
+}
+
+/*****************˶Աѡ·******************************
+ * ѡյɱѡ·,˶ÿ·ǷϷ
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵һ·߱·;ÿ·ߴ㵽յ,վ֮·,
+ *           ظվ,·֮ͬҲ·ߵROUTE_STRETCH;
+ *           ·߻ͬ
+ ************************************************************/
+void check_alternatives()
+{
+    if (check_S < 2)
+        return;
+    auto weight = [](int u, int v, int type)
     {
-        if (bus[bus_])
+        for (int i = h[u]; ~i; i = ne[i])
+            if (e[i] == v)
+                return type ? w[i] : dis[i];
+        return -1;
+    };
+
+    vector<vector<int>> routes;
+    vector<int> lengths;
+    for (int q = 0; q < 10; q++)
+    {
+        int s = check_rng() % check_S, t = (s + 1 + check_rng() % (check_S - 1)) % check_S;
+        int type = check_rng() % 2, k = check_rng() % 4 + 1;
+        int st = snap_station[s], ed = snap_station[t];
+        bool found = alternative_routes(st, ed, type, k, routes, lengths);
+        bool ok = found == (check_d[type][s][t] < 0x3f3f3f3f);
+        if (found)
         {
-            for (int i = h[bus_]; ~i; i = ne[i])
+            ok = ok && lengths[0] == check_d[type][s][t] && routes.size() == lengths.size() && (int)routes.size() <= k;
+            for (size_t r = 0; ok && r < routes.size(); r++)
             {
-                int j = e[i];
-                if (j == -1)
-                    continue;
-                edge[u_cnt] = {bus_, j, dis[i]};
-                edge[++u_cnt] = {j, bus_, dis[i]};
-                if (find(bus_) != find(j))
+                auto &route = routes[r];
+                int sum = 0;
+                ok = route.front() == st && route.back() == ed &&
+                     set<int>(route.begin(), route.end()).size() == route.size() &&
+                     lengths[r] <= ROUTE_STRETCH * lengths[0] + 1e-9;
+                for (size_t x = 1; ok && x < route.size(); x++)
                 {
-                    p[find(bus_)] = find(j);
-                    cnt++;
+                    int c = weight(route[x - 1], route[x], type);
+                    ok = c >= 0, sum += c;
                 }
+                ok = ok && sum == lengths[r] && count(routes.begin(), routes.end(), route) == 1;
             }
         }
+        check_expect("ѡ·", ok);
     }
+}
 
-    int count_number = 0;
-    map<int, vector<int>> count_bus_stop;
-    set<int> bus_vis;
-    for (auto bus_ : bus_line)
+/*****************˶ѯֱ߾½****************
+ * ÿվ,˶ֱ߾½A*,kվͰ뾶ڵվ
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵̾׼˶,ǰk·ʹ÷dijkstraʱ˶;
+ *           Ͱ뾶ѯֱ߾Ľ˶;ʱ
+ ************************************************************/
+void check_geo()
+{
+    for (int s = 0; s < check_S; s++)
     {
-        if (bus[bus_])
-        {
-            if (p[bus_] == bus_)
-                count_number++;
-            bus_vis.insert(p[bus_]), count_bus_stop[p[bus_]].push_back(bus_);
-        }
+        int v = snap_station[s];
+        geo_lat[v] = 30 + check_rng() % 10000 * 1e-5, geo_lon[v] = 120 + check_rng() % 10000 * 1e-5;
+        geo_has[v] = true;
     }
-    if (count_number == 1)
-    {
-        cout << "ùվܹһȦ " << endl;
-
-        int answer = 0;
-        for (auto bus_ : bus_line)
-            p[bus_] = bus_;
-        sort(edge, edge + u_cnt);
+    geo_project();
 
-        for (int i = 0; i < u_cnt; i++)
-        {
-            int u = edge[i].u, v = edge[i].v, w = edge[i].w;
-            if (find(u) != find(v))
+    if (geo_ready())
+    {
+        for (int s = 0; s < check_S; s++)
+            for (int t = 0; t < check_S; t++)
             {
-                p[find(u)] = find(v);
-                answer += w;
+                int ed = snap_station[t];
+                check_expect("ѯ", goal_query(snap_station[s], ed, 0) && dist[ed] == check_d[0][s][t]);
             }
-        }
 
-        cout << "һȦСȨֵΪ: " << answer << endl;
+        int a = snap_station[check_rng() % check_S], b = snap_station[check_rng() % check_S];
+        A_star(a, b, 20);
+        vector<int> with_geo = A_star_dist;
+        memset(geo_has, 0, sizeof geo_has);
+        geo_project();
+        dijkstra_dist(b);
+        A_star(a, b, 20);
+        check_expect("ѯ", A_star_dist == with_geo);
+        for (int s = 0; s < check_S; s++)
+            geo_has[snap_station[s]] = true;
+        geo_project();
     }
-    else
+
+    for (int q = 0; q < 10; q++)
     {
-        cout << "վ֮䲻ܻൽվ!" << endl
-             << endl
-             << endl;
-        cout << "һ " << count_number << " ͨĹվ,ֱ: " << endl;
-        count_number = 1;
-        for (auto bus_ : bus_vis)
+        int c = snap_station[check_rng() % check_S], k = check_rng() % (check_S + 2);
+        double x = geo_x[c] + (int)(check_rng() % 2001) - 1000, y = geo_y[c] + (int)(check_rng() % 2001) - 1000;
+        double radius = check_rng() % 3000;
+        vector<pair<double, int>> all, got;
+        for (int s = 0; s < check_S; s++)
         {
-            cout << "--------------- " << count_number++ << " --------------- " << endl;
-            for (auto bus__ : count_bus_stop[bus_])
-                cout << bus__ << " վ ";
-            cout << endl
-                 << "-------------------------------------" << endl;
+            int v = snap_station[s];
+            all.push_back({hypot(geo_x[v] - x, geo_y[v] - y), v});
         }
+        sort(all.begin(), all.end());
+
+        geo_nearest(x, y, k, got);
+        bool ok = (int)got.size() == min(k, check_S);
+        for (size_t i = 0; ok && i < got.size(); i++)
+            ok = got[i].first == all[i].first && got[i].first == hypot(geo_x[got[i].second] - x, geo_y[got[i].second] - y);
+        check_expect("ѯ", ok);
+
+        geo_radius(x, y, radius, got);
+        vector<pair<double, int>> want;
+        for (auto &item : all)
+            if (item.first <= radius)
+                want.push_back(item);
+        check_expect("ѯ", got == want);
     }
 
-    Sleep(1200);
-    return;
+    memset(geo_has, 0, sizeof geo_has);
+    geo_project();
 }
 
-/*****************վ֮ɾ***********************
- * վ֮ɾ
- *  յ
- *  
- * ֵ 0-ɹ   -ʧ
- * ˵
+/*****************˶Ƶϣ************************
+ * վ,ÿƶҪ鵽Լվ,ڵƲ鲻
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵ʱƱ
  ************************************************************/
-void make_delete()
+void check_dict()
 {
-    /**
-    úΪͼĽڵɾ,ʱ临ӶΪN
-    **/
-    cout << "ϳվյ: ";
-    cin >> make_delete_st >> make_delete_ed;
+    auto random_key = []()
+    {
+        string key;
+        for (int len = check_rng() % 8 + 1; len > 0; len--)
+            key += char('a' + check_rng() % 26);
+        return key;
+    };
 
-    bool flag_all = false;
-    for (int i = h[make_delete_st]; ~i; i = ne[i])
+    dict_arena.clear(), dict_keys.clear();
+    set<string> names;
+    for (int v = 0; v < check_S; v++)
     {
-        int j = e[i];
-        if (j == make_delete_ed)
-        {
-            flag_all = true;
-            e[i] = -1;
-            cout << endl
-                 << "ɾɹI(^^)J!" << endl
-                 << endl;
-        }
+        string key = random_key();
+        if (!names.insert(key).second)
+            continue;
+        dict_keys.push_back({(int)dict_arena.size(), (int)key.size(), snap_station[v]});
+        dict_arena += key;
     }
-
-    for (int i = h[make_delete_ed]; ~i; i = ne[i])
+    dict_build();
+    for (auto &key : dict_keys)
+        check_expect("ϣ", dict_lookup(dict_arena.substr(key.off, key.len)) == key.station);
+    for (int q = 0; q < 20; q++)
     {
-        int j = e[i];
-        if (j == make_delete_st)
-            e[i] = -1;
+        string key = random_key();
+        if (!names.count(key))
+            check_expect("ϣ", dict_lookup(key) == -1);
     }
+    dict_arena.clear(), dict_keys.clear();
+    dict_build();
+}
 
-    for (auto bus_ : bus_line)
+/*****************˶Խ****************************
+ * öվԼ,Brandes㷨Ľ˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵sigmaΪ·,ȨΪ1,;
+ *           վ·εĽҪ˶,Ƚʱ
+ ************************************************************/
+void check_betweenness()
+{
+    int S = check_S;
+    auto close = [](double a, double b)
     {
-        bool flag = false;
-        for (int i = h[bus_]; ~i; i = ne[i])
+        return fabs(a - b) <= 1e-6 * (1 + fabs(b));
+    };
+    for (int type = 0; type < 2; type++)
+    {
+        auto &d = check_d[type];
+        vector<vector<double>> sigma(S, vector<double>(S, 0));
+        for (int s = 0; s < S; s++)
         {
-            int j = e[i];
-            if (j != -1)
+            vector<int> order(S);
+            iota(order.begin(), order.end(), 0);
+            sort(order.begin(), order.end(), [&](int a, int b)
+                 { return d[s][a] < d[s][b]; });
+            sigma[s][s] = 1;
+            for (int t : order)
+                for (int k = snap_off[t]; k < snap_off[t + 1] && t != s; k++)
+                    if (d[s][snap_to[k]] + snap_wt[type][k] == d[s][t])
+                        sigma[s][t] += sigma[s][snap_to[k]];
+        }
+        vector<double> station_bc, segment_bc, want_station(S, 0), want_segment(idx / 2 + 1, 0);
+        for (int s = 0; s < S; s++)
+            for (int t = 0; t < S; t++)
             {
-                flag = true;
-                break;
+                if (s == t || d[s][t] >= 0x3f3f3f3f)
+                    continue;
+                for (int v = 0; v < S; v++)
+                    if (v != s && v != t && d[s][v] + d[v][t] == d[s][t])
+                        want_station[v] += 0.5 * sigma[s][v] * sigma[v][t] / sigma[s][t];
+                for (int u = 0; u < S; u++)
+                    for (int k = snap_off[u]; k < snap_off[u + 1]; k++)
+                        if (d[s][u] + snap_wt[type][k] + d[snap_to[k]][t] == d[s][t])
+                            want_segment[snap_eid[k] >> 1] += 0.5 * sigma[s][u] * sigma[snap_to[k]][t] / sigma[s][t];
             }
-        }
-        if (!flag)
-            bus[bus_] = false;
-        else
-            bus[bus_] = true;
+        betweenness(type, 0, station_bc, segment_bc);
+        for (int v = 0; v < S; v++)
+            check_expect("", close(station_bc[v], want_station[v]));
+        for (size_t x = 0; x < want_segment.size(); x++)
+            check_expect("", close(segment_bc[x], want_segment[x]));
     }
-    if (!flag_all)
-        cout << endl
-             << "·߲(ini)!" << endl
-             << endl;
-    Sleep(1000);
-    return;
 }
 
-/********************վ************************
- * վ
- *  յ
- *  
- * ֵ 0-ɹ   -ʧ
- * ˵
+/*****************˶ź͸******************************
+ * ɾ·,ɾվ,BFSͳƸֵվ,find_cut_points˶
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵Ҫ˶վ,Ҫ˶ɾֳɵĸֵվ
  ************************************************************/
-void make_new()
+void check_cut_points()
 {
-    /**
-    úΪͼĽڵ,ʱ临ӶΪN
-    **/
-    cout << "վ·߲뻨Ѻ;: ";
-    int cost, dist_;
-
-    cin >> make_new_st >> make_new_ed >> cost >> dist_;
-
-    for (int i = h[make_new_st]; ~i; i = ne[i])
+    int S = check_S;
+    auto pieces = [&](int skip_station, int skip_seg, vector<int> &label)
     {
-        int j = e[i];
-        if (j == make_new_st)
+        vector<int> size;
+        label.assign(S, -1);
+        for (int r = 0; r < S; r++)
         {
-            cout << "·Ѿ(ini)!" << endl;
-            Sleep(1500);
-            return;
+            if (r == skip_station || label[r] != -1)
+                continue;
+            queue<int> que;
+            que.push(r), label[r] = size.size(), size.push_back(1);
+            while (!que.empty())
+            {
+                int u = que.front();
+                que.pop();
+                for (int k = snap_off[u]; k < snap_off[u + 1]; k++)
+                {
+                    int j = snap_to[k];
+                    if (j == skip_station || (snap_eid[k] >> 1) == skip_seg || label[j] != -1)
+                        continue;
+                    label[j] = label[r], size[label[r]]++;
+                    que.push(j);
+                }
+            }
+        }
+        return size;
+    };
+    vector<array<int, 3>> bridges;
+    vector<pair<int, vector<int>>> cuts;
+    find_cut_points(bridges, cuts);
+    map<int, pii> got_bridge, want_bridge;
+    map<int, vector<int>> got_cut, want_cut;
+    for (auto &b : bridges)
+        got_bridge[b[0]] = {b[1], b[2]};
+    for (auto &c : cuts)
+        got_cut[c.first] = c.second;
+
+    vector<int> base, label;
+    pieces(-1, -1, base);
+    for (int u = 0; u < S; u++)
+        for (int k = snap_off[u]; k < snap_off[u + 1]; k++)
+        {
+            int seg = snap_eid[k] >> 1, j = snap_to[k];
+            if (u > j)
+                continue;
+            vector<int> size = pieces(-1, seg, label);
+            if (label[u] != label[j])
+                want_bridge[seg] = {min(size[label[u]], size[label[j]]), max(size[label[u]], size[label[j]])};
         }
+    for (int v = 0; v < S; v++)
+    {
+        vector<int> size = pieces(v, -1, label), parts;
+        vector<bool> seen(size.size(), false);
+        for (int u = 0; u < S; u++)
+            if (u != v && base[u] == base[v] && !seen[label[u]])
+                seen[label[u]] = true, parts.push_back(size[label[u]]);
+        sort(parts.begin(), parts.end());
+        if (parts.size() >= 2)
+            want_cut[v] = parts;
     }
+    check_expect("ź͸", got_bridge == want_bridge);
+    check_expect("ź͸", got_cut == want_cut);
+}
 
-    // ӱ,δֵվ,䴢
-    add(make_new_st, make_new_ed, cost, dist_), add(make_new_ed, make_new_st, cost, dist_);
-    if (!bus[make_new_st])
-        bus[make_new_st] = true;
-    if (!bus[make_new_ed])
-        bus[make_new_ed] = true;
+/*****************˶ִе˳************************
+ * һѯ,ط޸󽻸run_batchִ,˶ִ˳
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵޸Ƿֽ: ֮ǰ֮ǰִ,֮Ķ֮;
+ *           ޸֮ѯط֮ǰ,ͬ󱣳ԭ˳;
+ *           ÿӦ
+ ************************************************************/
+void check_batch()
+{
+    check_load();
+    int m = check_rng() % 12 + 1;
+    vector<int> ops(m);
+    auto station = [&]()
+    {
+        return snap_station[check_rng() % check_S];
+    };
+    ostringstream input;
+    input << m << endl;
+    for (int q = 0; q < m; q++)
+    {
+        int kind = check_rng() % 4;
+        ops[q] = kind == 0 ? 1 : kind == 1 ? 13 : kind == 2 ? 5 : 6;
+        input << ops[q] << ' ';
+        if (ops[q] == 1 || ops[q] == 5)
+            input << station() << ' ' << station();
+        else if (ops[q] == 13)
+            input << check_rng() % 2 << ' ' << check_rng() % 100 << " 1 " << station();
+        else
+            input << station() << ' ' << station() << ' ' << check_rng() % 20 + 1 << ' ' << check_rng() % 100 + 1;
+        input << endl;
+    }
 
-    cout << endl
-         << "ӳɹI(^^)J!" << endl
-         << endl;
+    // ӽаִ˳ȡ
+    string out = check_io(input.str(), run_batch), line;
+    size_t pos = out.find("ִ˳");
+    istringstream report(pos == string::npos ? "" : out.substr(pos));
+    vector<int> order;
+    bool ok = true;
+    while (getline(report, line))
+    {
+        int q;
+        if (sscanf(line.c_str(), "   %d", &q) != 1)
+            continue;
+        order.push_back(q - 1);
+        ok = ok && line.find("") != string::npos;
+    }
 
-    for (auto bus_ : bus_line)
+    vector<bool> seen(m, false);
+    ok = ok && (int)order.size() == m;
+    for (int q : order)
     {
-        bool flag = false;
-        for (int i = h[bus_]; ~i; i = ne[i])
+        ok = ok && q >= 0 && q < m && !seen[q];
+        if (q >= 0 && q < m)
+            seen[q] = true;
+    }
+    for (size_t i = 0; ok && i < order.size(); i++)
+        for (size_t j = i + 1; j < order.size(); j++)
         {
-            int j = e[i];
-            if (j != -1)
-            {
-                flag = true;
-                break;
-            }
+            int a = order[i], b = order[j];
+            int ca = query_class(ops[a]), cb = query_class(ops[b]);
+            bool barrier = ca == QUERY_EDIT || cb == QUERY_EDIT;
+            for (int x = min(a, b) + 1; x < max(a, b); x++)
+                barrier = barrier || query_class(ops[x]) == QUERY_EDIT;
+            if (barrier ? a > b : ca > cb || (ca == cb && a > b))
+                ok = false;
         }
-        if (!flag)
-            bus[bus_] = false;
-        else
-            bus[bus_] = true;
-    }
-    Sleep(1000);
-    return;
+    check_expect("ִе˳", ok);
 }
 
-/****************ѯеĹվϢ************************
- * ѯеĹվϢ
+/*****************˶Գʱȡ״̬**********************
+ * һǰk·ѯʱȡ,˶run_with_budgetص״̬
  *  
- *  վϸϢ
- * ֵ 0-ɹ   -ʧ
- * ˵
+ *  check_tally
+ * ֵ void
+ * ˵ԤΪ1ʱӦܿ췵سʱ;Ԥʱһ߳
+ *           ȡ(ģCtrl+C),Ӧȡ;ָԤ
  ************************************************************/
-void get_busline_all()
+void check_status()
 {
-    cout << "Ŀǰдڵվ: " << endl;
-    for (auto bustop : bus_line)
+    auto &seg = check_segs[check_rng() % check_segs.size()];
+    string input = to_string(seg[0]) + " " + to_string(seg[1]) + " 1000000";
+    int keep = query_budget[QUERY_HEAVY], status = -1;
+
+    query_budget[QUERY_HEAVY] = 1;
+    auto start = chrono::steady_clock::now();
+    check_io(input, [&]
+             { status = run_with_budget(3); });
+    double used = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    check_expect("ʱȡ", status == 1 && used < 1000);
+
+    query_budget[QUERY_HEAVY] = 0;
+    atomic<bool> finished(false);
+    auto cancel = [&]()
     {
-        if (bus[bustop])
+        this_thread::sleep_for(chrono::milliseconds(2));
+        while (!finished)
         {
-            cout << "----------ǰվ: " << bustop << "վ-----------" << endl;
-            cout << "ڸվϸϢ: " << endl;
-            for (int i = h[bustop]; ~i; i = ne[i])
-            {
-                int j = e[i];
-                if (j != -1)
-                    cout << "վ " << j << "վ ,վľ" << dis[i] << ",վ֮ĻΪ: " << w[i] << "Ԫ" << endl;
-            }
+            query_ctx.cancel = true; // run_with_budgetʼʱȡ,˷
+            this_thread::sleep_for(chrono::milliseconds(1));
         }
-    }
-    cout << endl;
-    Sleep(1500);
+    };
+    thread canceller(cancel);
+    check_io(input, [&]
+             { status = run_with_budget(3); });
+    finished = true;
+    canceller.join();
+    query_ctx.cancel = false;
+    check_expect("ʱȡ", status == 2);
+    query_budget[QUERY_HEAVY] = keep;
 }
 
-/****************ѯվϸϢ**********************
- * ѯվϸϢ
- *  վ
- *  վϸϢ
- * ֵ 0-ɹ   -ʧ
- * ˵
+/*****************˶ԳʱĲֽ**********************
+ * ĽֹʱA*Ԥڵ,˶ǰʱĲֽ
+ *  
+ *  check_tally
+ * ֵ void
+ * ˵ֹʱڿʼǰ0.1,ͣڵһʱӵλ,λ;
+ *           A*Ѿҵ·ǰ;
+ *           ԤڵѾѵվ,dijkstraͬ;ûгʱʱ;
+ *           滻ֵͼ,˷ڻ޸ͼļ
  ************************************************************/
-void get_busline_single()
+void check_partial()
 {
-    int now_bus;
-    cout << "ѯվ: ";
-    cin >> now_bus;
-    if (!bus[now_bus])
-        cout << endl
-             << "վ㲻ڻѱɾ(ini)" << endl;
+    check_load();
+    auto limit = [&]()
+    {
+        query_ctx.status = 0;
+        query_ctx.limited = true;
+        query_ctx.deadline = chrono::steady_clock::now() + chrono::microseconds((int)(check_rng() % 200) - 100);
+    };
+    auto unlimit = [&]()
+    {
+        bool expired = query_ctx.status == 1;
+        query_ctx.limited = false;
+        query_ctx.status = 0;
+        return expired;
+    };
+
+    int s = check_rng() % check_S, t = check_rng() % check_S, k = 2000;
+    int a = snap_station[s], b = snap_station[t];
+    dijkstra_dist(b); // ûALTʱ,A*÷dijkstraĽΪۺ
+    A_star(a, b, k);
+    vector<int> full = A_star_dist;
+    for (int q = 0; q < 3; q++)
+    {
+        limit();
+        A_star(a, b, k);
+        bool expired = unlimit();
+        bool ok = A_star_dist.size() <= full.size() && equal(A_star_dist.begin(), A_star_dist.end(), full.begin());
+        check_expect("ʱĲֽ", ok && (expired || A_star_dist.size() == full.size()));
+    }
+
+    // Сͼϵٿʱӵļ,Ԥڵ60x60Ϻ˶
+    const int W = 60;
+    memset(h, -1, sizeof h);
+    idx = 0;
+    for (int v : bus_line)
+        bus[v] = false;
+    bus_line.clear();
+    comp_reset();
+    for (int v = 0; v < W * W; v++)
+    {
+        if (v % W + 1 < W)
+            add_route(v, v + 1, check_rng() % 20 + 1, check_rng() % 100 + 1);
+        if (v + W < W * W)
+            add_route(v, v + W, check_rng() % 20 + 1, check_rng() % 100 + 1);
+    }
+    int src = check_rng() % (W * W), type = check_rng() % 2;
+    if (type)
+        dijkstra_cost(src);
     else
+        dijkstra_dist(src);
+    vector<int> want(dist, dist + W * W);
+    vector<pii> reached;
+    for (int q = 0; q < 5; q++)
     {
-        cout << "----------ǰվ: " << now_bus << "վ-----------" << endl;
-        cout << "ڸվϸϢ: " << endl;
-        for (int i = h[now_bus]; ~i; i = ne[i])
-        {
-            int j = e[i];
-            if (e[i] != -1)
-                cout << "վ " << e[i] << "վ,վľ" << dis[i] << ",վ֮ĻΪ: " << w[i] << "Ԫ" << endl
-                     << endl;
-        }
+        int budget = check_rng() % (type ? 1000 : 5000), inside = 0;
+        limit();
+        bounded_search({src}, type, budget, reached);
+        bool expired = unlimit();
+        for (int v = 0; v < W * W; v++)
+            inside += want[v] <= budget;
+        bool ok = expired ? (int)reached.size() <= inside : (int)reached.size() == inside;
+        for (auto &r : reached)
+            ok = ok && r.first < W * W && r.second == want[r.first];
+        check_expect("ʱĲֽ", ok);
     }
-    Sleep(1500);
 }
 
+/*****************ͼϵԼ***************************
+ * ɵСͼ,Ѹּٲѯ,͵ȵĽֱӼĽһ˶
+ *  ͼĸ
+ *  ÿһĴͲһµĴ
+ * ֵ һµܴ
+ * ˵ --check ʱִ,ȡҲ޸ѱ·;
+ *           ÿһcheck_ͷĺ,ֻȡͼ,ñֵĻ׼,
+ *           ޸ͼĸȵcheck_load()ֵָͼ;
+ *           õALT,,ʱ̱״̬Լڽʱ
+ ************************************************************/
+int self_check(int rounds)
+{
+    check_rng.seed(20241018);
+    check_tally.clear();
+    for (int round = 0; round < rounds; round++)
+    {
+        if (!check_graph())
+            continue;
+
+        // ֻȡͼļ
+        check_delta_stepping();
+        check_apsp();
+        check_bounded_search();
+        check_compressed();
+        check_alt();
+        check_td();
+        check_csa();
+        check_phast();
+        check_hub();
+        check_alternatives();
+        check_geo();
+        check_dict();
+        check_betweenness();
+        check_cut_points();
+        check_status();
+
+        // ޸ͼļ
+        check_reorder();
+        check_components();
+        check_journal();
+        check_batch();
+        check_partial();
+    }
+
+    long long wrong = 0;
+    cout << " " << rounds << " ͼϺ˶ԼٲѯֱӼĽ: " << endl;
+    for (auto &t : check_tally)
+    {
+        cout << "  " << t.first << ": ˶ " << t.second.first << " ,һ " << t.second.second << " " << endl;
+        wrong += t.second.second;
+    }
+    cout << (wrong ? "Լʧ(ini)" : "ԼͨI(^^)J") << endl;
+    return wrong;
+}
 /*****************·************************
  * ·
  *  վĿԼ·
@@ -994,22 +6945,13 @@ void create_BusStop()
     cout << "ע: ظıϵͳһ,ϵͳвرߺԻĴ" << endl
          << endl;
     memset(h, -1, sizeof h);
+    comp_reset();
 
     for (int i = 1; i <= m; i++)
     {
         int u, v, c, d;
         cin >> u >> v >> c >> d;
-        add(u, v, c, d), add(v, u, c, d); // 
-        if (!bus[u])
-        {
-            bus_line.push_back(u);
-            bus[u] = true;
-        }
-        if (!bus[v])
-        {
-            bus_line.push_back(v);
-            bus[v] = true;
-        }
+        add_route(u, v, c, d);
     }
 }
 
@@ -1035,52 +6977,56 @@ void pprint()
     cout << "8 : ȡվϸϢ" << endl;                 // ʱ临Ӷn
     cout << "9 : ȡ֮ҪתС·" << endl;
     cout << "10: ȡЩվܹ֮ൽԼվСȨֵ" << endl;
+    cout << "11: м㵥Դ·ٱ(delta-stepping)" << endl;
+    cout << "12: رȫԴ·ģʽ(ڼǧվ)" << endl;
+    cout << "13: ѯڸ򻨷ܵվ(ֶ֧)" << endl;
+    cout << "14: BFS,RCMϣ˳վ±,߻" << endl;
+    cout << "15: ѹڽӱڴռúͲѯٶ" << endl;
+    cout << "16: ·ղ޸־" << endl;
+    cout << "17: رALTر(A*ʹõر½)" << endl;
+    cout << "18: ·ηʱεʻʱ" << endl;
+    cout << "19: ʱ̲ѯ絽ʱ" << endl;
+    cout << "20: ¼ʱ̱(εͣվʱ)" << endl;
+    cout << "21: ʱ̱ѯ絽ʱʱ䴰ڵĳ" << endl;
+    cout << "22: վĿɴԱ(PHAST)" << endl;
+    cout << "23: ǩ: ,,ѯվľͻ" << endl;
+    cout << "24: ѯվ֮伸Եıѡ·" << endl;
+    cout << "25: ¼վľγ" << endl;
+    cout << "26: ѯĳλøվ" << endl;
+    cout << "27: ¼վƺͱ(֮ѯʱֱƻ)" << endl;
+    cout << "28: վ·εĽ(·)" << endl;
+    cout << "29: ҳرպʹ·Ͽ·κվ" << endl;
+    cout << "30: õѯطʱԤ(ѯаCtrl+Cȡ)" << endl;
+    cout << "31: ִ(ѯ,ÿ״̬ʱ)" << endl;
     cout << endl
          << endl
          << ": ";
 }
 
-int main()
+int main(int argc, char *argv[])
 {
-    create_BusStop(); // ͼ
-
-    pprint();
+    if (argc > 1 && strcmp(argv[1], "--check") == 0) // ֻԼ,ȡ·
+        return self_check(argc > 2 ? atoi(argv[2]) : 100) ? 1 : 0;
 
-    while (cin >> op, op != -1)
+    journal_enabled = argc > 1 && strcmp(argv[1], "--journal") == 0; // Ĭϲдպ־
+    if (!journal_enabled)
+        create_BusStop(); // ͼ
+    else if (!journal_recover()) // ȴӿպ־ָ
     {
+        create_BusStop();
+        journal_checkpoint();
+    }
 
-        if (op == 1)
-            query_min_dist(1);
-
-        else if (op == 2)
-            query_min_cost();
-
-        else if (op == 3)
-            query_min_dist(3);
-
-        else if (op == 4)
-            quert_count_dist_and_cost();
-
-        else if (op == 5)
-            make_delete();
-
-        else if (op == 6)
-            make_new();
-
-        else if (op == 7)
-            get_busline_all();
-
-        else if (op == 8)
-            get_busline_single();
-
-        else if (op == 9)
-            get_min_change();
+    SetConsoleCtrlHandler(query_ctrl_handler, TRUE); // ѯаCtrl+Cֻȡβѯ
 
-        else if (op == 10)
-            query_last_number();
+    pprint();
 
+    while (cin >> op, op != -1)
+    {
+        if (op == 31)
+            run_batch();
         else
-            cout << "ùܲ(ini),ڸĽ,ҪĹovo!" << endl;
+            run_with_budget(op);
 
         pprint();
     }